@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsArchive.h"
+
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+const TCHAR* const FSettingsArchive::Extension = TEXT("uesettings");
+
+namespace
+{
+    constexpr uint32 ArchiveMagic = 0x4B50'4D53; // "SMPK"
+    constexpr uint32 ArchiveVersion = 1;
+    // a section is a few kilobytes of ini text, so anything claiming to be much larger is a corrupt or crafted archive rather than an allocation to make
+    constexpr int32 MaxRawSize = 64 * 1024 * 1024;
+
+    enum EArchiveFlags : uint32
+    {
+        ArchiveFlag_Compressed = 1 << 0,
+    };
+}
+
+bool FSettingsArchive::Write(const FString& ArchivePath, const TArray<FCapturedSettingsSection>& Sections, bool Compress)
+{
+    TArray<uint8> Blobs;
+    TArray<FTocEntry> TocEntries;
+    TocEntries.Reserve(Sections.Num());
+
+    for (const FCapturedSettingsSection& Section : Sections)
+    {
+        const FTCHARToUTF8 Utf8Contents(*Section.Contents);
+
+        FTocEntry& Entry = TocEntries.AddDefaulted_GetRef();
+        Entry.Offset = Blobs.Num();
+        Entry.RawSize = Utf8Contents.Length();
+        Entry.StoredSize = Entry.RawSize;
+
+        if (Compress)
+        {
+            TArray<uint8> CompressedContents;
+            int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Entry.RawSize);
+            CompressedContents.SetNumUninitialized(CompressedSize);
+            if (!FCompression::CompressMemory(NAME_Zlib, CompressedContents.GetData(), CompressedSize, Utf8Contents.Get(), Entry.RawSize))
+            {
+                return false;
+            }
+
+            Entry.StoredSize = CompressedSize;
+            Blobs.Append(CompressedContents.GetData(), CompressedSize);
+        }
+        else
+        {
+            Blobs.Append(reinterpret_cast<const uint8*>(Utf8Contents.Get()), Entry.RawSize);
+        }
+    }
+
+    TArray<uint8> FileData;
+    FMemoryWriter Writer(FileData);
+
+    uint32 Magic = ArchiveMagic;
+    uint32 Version = ArchiveVersion;
+    uint32 Flags = Compress ? ArchiveFlag_Compressed : 0;
+    int32 NumEntries = Sections.Num();
+    Writer << Magic << Version << Flags << NumEntries;
+
+    for (int32 Index = 0; Index < Sections.Num(); ++Index)
+    {
+        FString ContainerName = Sections[Index].Key.ContainerName.ToString();
+        FString CategoryName = Sections[Index].Key.CategoryName.ToString();
+        FString SectionName = Sections[Index].Key.SectionName.ToString();
+        FTocEntry& Entry = TocEntries[Index];
+        Writer << ContainerName << CategoryName << SectionName << Entry.Offset << Entry.StoredSize << Entry.RawSize;
+    }
+
+    FileData.Append(Blobs);
+    return FFileHelper::SaveArrayToFile(FileData, *ArchivePath);
+}
+
+TSharedPtr<FSettingsArchive> FSettingsArchive::Open(const FString& ArchivePath)
+{
+    TArray<uint8> FileData;
+    if (!FFileHelper::LoadFileToArray(FileData, *ArchivePath))
+    {
+        return nullptr;
+    }
+
+    FMemoryReader Reader(FileData);
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    uint32 Flags = 0;
+    int32 NumEntries = 0;
+    Reader << Magic << Version << Flags << NumEntries;
+    if (Reader.IsError() || Magic != ArchiveMagic || Version > ArchiveVersion || NumEntries < 0)
+    {
+        return nullptr;
+    }
+
+    const TSharedRef<FSettingsArchive> Archive = MakeShared<FSettingsArchive>();
+    Archive->FilePath = ArchivePath;
+    Archive->IsCompressed = (Flags & ArchiveFlag_Compressed) != 0;
+    Archive->Keys.Reserve(NumEntries);
+    Archive->Toc.Reserve(NumEntries);
+
+    for (int32 Index = 0; Index < NumEntries; ++Index)
+    {
+        FString ContainerName;
+        FString CategoryName;
+        FString SectionName;
+        FTocEntry Entry;
+        Reader << ContainerName << CategoryName << SectionName << Entry.Offset << Entry.StoredSize << Entry.RawSize;
+        if (Reader.IsError())
+        {
+            return nullptr;
+        }
+
+        const FSettingsSectionKey Key{ FName{ *ContainerName }, FName{ *CategoryName }, FName{ *SectionName } };
+        Archive->Keys.Add(Key);
+        Archive->Toc.Add(Key, Entry);
+    }
+
+    const int64 TocEnd = Reader.Tell();
+    for (const auto& [Key, Entry] : Archive->Toc)
+    {
+        // compared against the bytes left after the table of contents, since adding the offset of a corrupt or crafted entry could overflow
+        const int64 NumBlobBytes = FileData.Num() - TocEnd;
+        if (Entry.Offset < 0 || Entry.StoredSize < 0 || Entry.RawSize < 0 || Entry.StoredSize > NumBlobBytes ||
+            Entry.Offset > NumBlobBytes - Entry.StoredSize)
+        {
+            return nullptr;
+        }
+
+        // uncompressed entries are read as stored, and compressed ones are inflated into a buffer of RawSize
+        if (Archive->IsCompressed ? Entry.RawSize > MaxRawSize : Entry.RawSize != Entry.StoredSize)
+        {
+            return nullptr;
+        }
+    }
+
+    Archive->Data = MoveTemp(FileData);
+    Archive->BlobsOffset = TocEnd;
+
+    return Archive;
+}
+
+bool FSettingsArchive::ReadSection(const FSettingsSectionKey& Key, FString& OutContents) const
+{
+    const FTocEntry* Entry = Toc.Find(Key);
+    if (Entry == nullptr)
+    {
+        return false;
+    }
+
+    const uint8* StoredContents = Data.GetData() + BlobsOffset + Entry->Offset;
+
+    TArray<uint8> UncompressedContents;
+    if (IsCompressed)
+    {
+        check(Entry->RawSize <= MaxRawSize);
+        UncompressedContents.SetNumUninitialized(Entry->RawSize);
+        if (!FCompression::UncompressMemory(NAME_Zlib, UncompressedContents.GetData(), Entry->RawSize, StoredContents, Entry->StoredSize))
+        {
+            return false;
+        }
+        StoredContents = UncompressedContents.GetData();
+    }
+
+    const FUTF8ToTCHAR Contents(reinterpret_cast<const ANSICHAR*>(StoredContents), Entry->RawSize);
+    OutContents = FString(Contents.Length(), Contents.Get());
+    return true;
+}
@@ -3,8 +3,12 @@
 #include "SettingsManager.h"
 
 #include "DesktopPlatformModule.h"
+#include "SettingsArchive.h"
 #include "SettingsManagerCommands.h"
+#include "SettingsManagerOperations.h"
 #include "SettingsManagerStyle.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
 
 static const FName ExportTabName("ExportTab");
 static const FName ImportTabName("ImportTab");
@@ -15,6 +19,8 @@ void FSettingsManagerModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 
+    AliveToken = MakeShared<bool>(true);
+
     FSettingsManagerStyle::Initialize();
     FSettingsManagerStyle::ReloadTextures();
 
@@ -30,6 +36,10 @@ void FSettingsManagerModule::StartupModule()
         FSettingsManagerCommands::Get().OpenImportWindow,
         FExecuteAction::CreateRaw(this, &FSettingsManagerModule::ImportButtonClicked),
         FCanExecuteAction());
+    PluginCommands->MapAction(
+        FSettingsManagerCommands::Get().OpenImportArchiveWindow,
+        FExecuteAction::CreateRaw(this, &FSettingsManagerModule::ImportArchiveButtonClicked),
+        FCanExecuteAction());
 
     UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FSettingsManagerModule::RegisterMenus));
 
@@ -49,7 +59,7 @@ TSharedRef<SDockTab> FSettingsManagerModule::OnSpawnTab([[maybe_unused]] const F
         return SNew(SDockTab)
             .TabRole(ETabRole::NomadTab)
             [
-                SNew(SSettingsManagerWindow, true, SSettingsManagerWindow::FImportData{})
+                SNew(SSettingsManagerWindow, true, nullptr)
             ];
     }
     else
@@ -57,7 +67,7 @@ TSharedRef<SDockTab> FSettingsManagerModule::OnSpawnTab([[maybe_unused]] const F
         return SNew(SDockTab)
             .TabRole(ETabRole::NomadTab)
             [
-                SNew(SSettingsManagerWindow, false, ImportData)
+                SNew(SSettingsManagerWindow, false, ImportManifest)
             ];
     }
 }
@@ -77,6 +87,8 @@ void FSettingsManagerModule::ShutdownModule()
 
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ExportTabName);
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ImportTabName);
+
+	AliveToken.Reset();
 }
 
 void FSettingsManagerModule::ExportButtonClicked()
@@ -86,6 +98,15 @@ void FSettingsManagerModule::ExportButtonClicked()
 
 void FSettingsManagerModule::ImportButtonClicked()
 {
+    // the folder being scanned opens the import tab once done, so picking another one now would be ignored
+    if (IsScanningImportSource)
+    {
+        FNotificationInfo Info(LOCTEXT("AlreadyScanningImportSource", "Still scanning the settings to import, the import tab opens once done"));
+        Info.ExpireDuration = 5.f;
+        FSlateNotificationManager::Get().AddNotification(Info);
+        return;
+    }
+
     const TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
     const void* ParentWindowHandle =
         ParentWindow.IsValid() && ParentWindow->GetNativeWindow().IsValid() ?
@@ -99,32 +120,91 @@ void FSettingsManagerModule::ImportButtonClicked()
     {
         return;
     }
-    
-    ImportData.Empty();
 
-    FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*OutFolder, [this](const TCHAR* Directory, bool bIsDirectory)
+    IsScanningImportSource = true;
+
+    FNotificationInfo ProgressInfo(LOCTEXT("ScanningImportSource", "Scanning settings to import..."));
+    ProgressInfo.bFireAndForget = false;
+    const TSharedPtr<SNotificationItem> ProgressNotification = FSlateNotificationManager::Get().AddNotification(ProgressInfo);
+    if (ProgressNotification.IsValid())
+    {
+        ProgressNotification->SetCompletionState(SNotificationItem::CS_Pending);
+    }
+
+    // reopening the same folder reuses the files found last time, whose contents are only read when importing,
+    // unless files were added, removed or modified since, which is checked along with the scan so that the editor never waits on the folder
+    FSettingsManagerOperations::ScanImportDirectoryAsync(OutFolder, ImportManifest,
+        [this, WeakAliveToken = TWeakPtr<bool>(AliveToken), ProgressNotification](const FSettingsImportManifest& ScannedManifest)
         {
-            if (!bIsDirectory)
+            // the module may have been shut down while scanning
+            if (!WeakAliveToken.IsValid())
             {
-                return true;
+                return;
             }
+            IsScanningImportSource = false;
 
-            const FName CategoryName = FName{ *FPaths::GetPathLeaf(Directory) };
-            TMap<FName, FString>& Category = ImportData.Add(CategoryName);
+            if (ProgressNotification.IsValid())
+            {
+                ProgressNotification->SetCompletionState(SNotificationItem::CS_None);
+                ProgressNotification->ExpireAndFadeout();
+            }
 
-            FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(Directory,
-                [this, &Category](const TCHAR* FileName, bool bIsDirectory)
+            // a reused scan was already reported
+            if (ImportManifest.Get() != &ScannedManifest.Get())
+            {
+                for (const FString& InvalidFile : ScannedManifest->InvalidFiles)
                 {
-                    if (!bIsDirectory && FPaths::GetExtension(FileName) == "ini")
-                    {
-                        Category.Add(FName{ *FPaths::GetBaseFilename(FileName) }, FileName);
-                    }
-                    
-                    return true;
-                });
-
-            return true;
+                    UE_LOG(LogSettingsManager, Warning, TEXT("Skipping '%s', which couldn't be read as a config file"), *InvalidFile);
+                }
+            }
+
+            ImportManifest = ScannedManifest;
+
+            FGlobalTabmanager::Get()->TryInvokeTab(ImportTabName);
         });
+}
+
+void FSettingsManagerModule::ImportArchiveButtonClicked()
+{
+    const TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().GetActiveTopLevelWindow();
+    const void* ParentWindowHandle =
+        ParentWindow.IsValid() && ParentWindow->GetNativeWindow().IsValid() ?
+        ParentWindow->GetNativeWindow()->GetOSWindowHandle() :
+        nullptr;
+
+    TArray<FString> OutFiles;
+    if (!FDesktopPlatformModule::Get()->OpenFileDialog(ParentWindowHandle,
+        LOCTEXT("ImportSettingsArchiveDialogTitle", "Import settings archive...").ToString(),
+        FPaths::GetPath(GEditorSettingsIni), FString(),
+        FString::Printf(TEXT("Settings Archive (*.%s)|*.%s"), FSettingsArchive::Extension, FSettingsArchive::Extension),
+        EFileDialogFlags::None, OutFiles) || OutFiles.Num() == 0)
+    {
+        return;
+    }
+
+    // the archive is reopened when it was exported again since, instead of importing its old contents
+    const FSettingsSourceStamp SourceStamp = FSettingsManagerOperations::GetSourceStamp(OutFiles[0]);
+    if (ImportManifest.IsValid() && ImportManifest->Archive.IsValid() && FPaths::IsSamePath(ImportManifest->Source, OutFiles[0]) &&
+        ImportManifest->SourceStamp == SourceStamp)
+    {
+        FGlobalTabmanager::Get()->TryInvokeTab(ImportTabName);
+        return;
+    }
+
+    const TSharedPtr<FSettingsArchive> Archive = FSettingsArchive::Open(OutFiles[0]);
+    if (!Archive.IsValid())
+    {
+        FNotificationInfo Info(FText::Format(LOCTEXT("InvalidSettingsArchive", "{0} isn't a valid settings archive"), FText::FromString(OutFiles[0])));
+        Info.ExpireDuration = 10.f;
+        FSlateNotificationManager::Get().AddNotification(Info)->SetCompletionState(SNotificationItem::CS_Fail);
+        return;
+    }
+
+    FSettingsImportData ArchiveData;
+    ArchiveData.Archive = Archive;
+    ArchiveData.Source = OutFiles[0];
+    ArchiveData.SourceStamp = SourceStamp;
+    ImportManifest = MakeShared<const FSettingsImportData>(MoveTemp(ArchiveData));
 
     FGlobalTabmanager::Get()->TryInvokeTab(ImportTabName);
 }
@@ -140,6 +220,7 @@ void FSettingsManagerModule::RegisterMenus()
 			FToolMenuSection& Section = Menu->FindOrAddSection("Configuration");
 			Section.AddMenuEntryWithCommandList(FSettingsManagerCommands::Get().OpenExportWindow, PluginCommands);
 			Section.AddMenuEntryWithCommandList(FSettingsManagerCommands::Get().OpenImportWindow, PluginCommands);
+			Section.AddMenuEntryWithCommandList(FSettingsManagerCommands::Get().OpenImportArchiveWindow, PluginCommands);
 		}
 	}
 }
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsManagerCommandlet.h"
+
+#include "SettingsArchive.h"
+#include "SettingsManagerLibrary.h"
+#include "SettingsManagerOperations.h"
+
+USettingsManagerCommandlet::USettingsManagerCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+
+    HelpDescription = TEXT("Bulk exports or imports Editor Preferences and Project Settings, or rolls an import back.");
+    HelpUsage = TEXT("-run=SettingsManager -Mode=<Export|Import> <-Dir=<Folder>|-Archive=<File>> [-Incremental] [-Container=<Editor|Project|All>] [-Preset=<Name>] [-Include=<Patterns>] [-Exclude=<Patterns>] [-IncludeKeys=<Patterns>] [-ExcludeKeys=<Patterns>] [-Merge]\n")
+        TEXT("-run=SettingsManager -Mode=Rollback [-Snapshot=<Name>]");
+    HelpParamNames = { TEXT("Mode"), TEXT("Dir"), TEXT("Archive"), TEXT("Incremental"), TEXT("Container"), TEXT("Preset"), TEXT("Include"), TEXT("Exclude"), TEXT("IncludeKeys"), TEXT("ExcludeKeys"), TEXT("Merge"), TEXT("Snapshot") };
+    HelpParamDescriptions = {
+        TEXT("Export, Import, or Rollback to restore the sections snapshotted before an import."),
+        TEXT("Folder to export to or import from, laid out as Category/Section.ini."),
+        TEXT("Single settings archive to export to or import from, instead of a folder."),
+        TEXT("Export to a folder only rewriting the files whose contents changed since the last export there."),
+        TEXT("Settings container to use. Defaults to Editor."),
+        TEXT("Only the sections of this preset, as saved from the Presets menu of the export/import windows."),
+        TEXT("Comma-separated wildcards over Category/Section names to include. A pattern without '/' matches a whole category."),
+        TEXT("Comma-separated wildcards over Category/Section names to exclude."),
+        TEXT("Comma-separated wildcards over config key names to include, or over IniSection:Key for patterns with a ':'. The other keys are neither written nor imported."),
+        TEXT("Comma-separated wildcards over config key names to exclude."),
+        TEXT("Import by three-way merging each key with its engine default and local value, instead of overwriting the sections."),
+        TEXT("Snapshot to roll back to, as listed by the SettingsManager.ListSnapshots console command. Defaults to the newest one."),
+    };
+}
+
+int32 USettingsManagerCommandlet::Main(const FString& Params)
+{
+    FString Mode;
+    FString Folder;
+    FString ArchivePath;
+    FString ContainerName = TEXT("Editor");
+    FString PresetName;
+    FString IncludeList;
+    FString ExcludeList;
+    FString IncludeKeyList;
+    FString ExcludeKeyList;
+    FParse::Value(*Params, TEXT("Mode="), Mode);
+    FParse::Value(*Params, TEXT("Dir="), Folder);
+    FParse::Value(*Params, TEXT("Archive="), ArchivePath);
+    FParse::Value(*Params, TEXT("Container="), ContainerName);
+    FParse::Value(*Params, TEXT("Preset="), PresetName, false);
+    FParse::Value(*Params, TEXT("Include="), IncludeList, false);
+    FParse::Value(*Params, TEXT("Exclude="), ExcludeList, false);
+    FParse::Value(*Params, TEXT("IncludeKeys="), IncludeKeyList, false);
+    FParse::Value(*Params, TEXT("ExcludeKeys="), ExcludeKeyList, false);
+
+    if (Mode == TEXT("Rollback"))
+    {
+        FString SnapshotName;
+        FParse::Value(*Params, TEXT("Snapshot="), SnapshotName);
+
+        const FSettingsManagerResult Result = USettingsManagerLibrary::RollbackSettings(SnapshotName);
+        USettingsManagerLibrary::LogResult(Mode, SnapshotName.IsEmpty() ? TEXT("the newest snapshot") : SnapshotName, Result);
+        return Result.NumFailed == 0 ? 0 : 1;
+    }
+
+    const bool IsForExport = Mode == TEXT("Export");
+    if ((!IsForExport && Mode != TEXT("Import")) || Folder.IsEmpty() == ArchivePath.IsEmpty())
+    {
+        UE_LOG(LogSettingsManager, Error, TEXT("Usage: %s"), *HelpUsage);
+        return 1;
+    }
+
+    if (!ArchivePath.IsEmpty() && FPaths::GetExtension(ArchivePath) != FSettingsArchive::Extension)
+    {
+        UE_LOG(LogSettingsManager, Error, TEXT("Settings archives must have the .%s extension"), FSettingsArchive::Extension);
+        return 1;
+    }
+
+    const FString& Path = ArchivePath.IsEmpty() ? Folder : ArchivePath;
+    const FSettingsManagerResult Result = IsForExport ?
+        USettingsManagerLibrary::ExportSettings(Path, ContainerName, PresetName, IncludeList, ExcludeList, FParse::Param(*Params, TEXT("Incremental")),
+            IncludeKeyList, ExcludeKeyList) :
+        USettingsManagerLibrary::ImportSettings(Path, ContainerName, PresetName, IncludeList, ExcludeList, IncludeKeyList, ExcludeKeyList,
+            FParse::Param(*Params, TEXT("Merge")));
+    USettingsManagerLibrary::LogResult(Mode, ContainerName, Result);
+
+    return Result.NumFailed == 0 ? 0 : 1;
+}
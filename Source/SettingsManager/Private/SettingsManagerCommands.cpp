@@ -8,6 +8,7 @@ void FSettingsManagerCommands::RegisterCommands()
 {
 	UI_COMMAND(OpenExportWindow, "Bulk Export Settings", "Bulk export Editor Preferences or Project Settings", EUserInterfaceActionType::Button, FInputChord());
 	UI_COMMAND(OpenImportWindow, "Bulk Import Settings", "Bulk import Editor Preferences or Project Settings", EUserInterfaceActionType::Button, FInputChord());
+	UI_COMMAND(OpenImportArchiveWindow, "Bulk Import Settings from Archive", "Bulk import Editor Preferences or Project Settings from a settings archive", EUserInterfaceActionType::Button, FInputChord());
 }
 
 #undef LOCTEXT_NAMESPACE
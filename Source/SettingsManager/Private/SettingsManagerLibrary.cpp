@@ -0,0 +1,363 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsManagerLibrary.h"
+
+#include "ISettingsCategory.h"
+#include "ISettingsContainer.h"
+#include "ISettingsModule.h"
+#include "ISettingsSection.h"
+#include "SettingsArchive.h"
+#include "SettingsManagerOperations.h"
+#include "SettingsPresets.h"
+#include "SettingsSnapshots.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    /** Fills the result in from the outcome of each section and the failures reported along the way. */
+    void FillResult(FSettingsManagerResult& Result, const TArray<FSettingsSectionResult>& SectionResults, const TArray<FText>& Failures, double StartTime)
+    {
+        Result.Sections.Reserve(SectionResults.Num());
+        for (const FSettingsSectionResult& SectionResult : SectionResults)
+        {
+            FSettingsManagerSectionResult& Entry = Result.Sections.AddDefaulted_GetRef();
+            Entry.Container = SectionResult.Key.ContainerName;
+            Entry.Category = SectionResult.Key.CategoryName;
+            Entry.Section = SectionResult.Key.SectionName;
+            Entry.Status = static_cast<ESettingsManagerSectionStatus>(SectionResult.Status);
+            Entry.ElapsedMilliseconds = SectionResult.ElapsedSeconds * 1000.0;
+            Entry.NumBytes = SectionResult.NumBytes;
+
+            Result.NumFailed += SectionResult.Status == ESettingsSectionStatus::Failed ? 1 : 0;
+        }
+
+        for (const FText& Failure : Failures)
+        {
+            Result.Errors.Add(Failure.ToString());
+        }
+
+        Result.ElapsedMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    }
+
+    FSettingsManagerResult Run(bool IsForExport, const FString& Path, const FString& ContainerName, const FString& PresetName,
+        const FString& IncludeList, const FString& ExcludeList, const FString& IncludeKeyList, const FString& ExcludeKeyList, bool Incremental, bool Merge)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        FSettingsManagerResult Result;
+
+        const auto Fail = [&Result](FString Error)
+            {
+                Result.Errors.Add(MoveTemp(Error));
+                ++Result.NumFailed;
+                return Result;
+            };
+
+        if (Path.IsEmpty())
+        {
+            return Fail(TEXT("No folder or archive given"));
+        }
+
+        // every container is handled in the same run, each in its own subfolder of a combined export
+        const bool IsCombined = ContainerName == USettingsManagerLibrary::AllContainers;
+        TArray<TSharedPtr<ISettingsContainer>> SettingsContainers;
+        if (IsCombined)
+        {
+            SettingsContainers = FSettingsManagerOperations::GetContainers();
+        }
+        else if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+        {
+            if (const TSharedPtr<ISettingsContainer> SettingsContainer = SettingsModule->GetContainer(FName{ *ContainerName });
+                SettingsContainer.IsValid())
+            {
+                SettingsContainers.Add(SettingsContainer);
+            }
+        }
+        if (SettingsContainers.IsEmpty())
+        {
+            return Fail(FString::Printf(TEXT("Unknown settings container '%s'"), *ContainerName));
+        }
+
+        TOptional<TSet<FSettingsSectionKey>> PresetKeys;
+        if (!PresetName.IsEmpty() && !FSettingsPresets::LoadPreset(PresetName, PresetKeys.Emplace()))
+        {
+            return Fail(FString::Printf(TEXT("Unknown preset '%s'"), *PresetName));
+        }
+
+        const FSettingsSectionFilter Filter = FSettingsSectionFilter::Parse(IncludeList, ExcludeList);
+        const TSharedPtr<const FSettingsKeyFilter> KeyFilter = FSettingsKeyFilter::Parse(IncludeKeyList, ExcludeKeyList);
+        const bool IsArchive = FPaths::GetExtension(Path) == FSettingsArchive::Extension;
+        const FString Folder = IsArchive ? FPaths::GetPath(Path) : Path;
+
+        TArray<FSettingsSectionFile> Sections;
+        TSharedPtr<FSettingsArchive> Archive;
+        if (IsForExport)
+        {
+            for (const TSharedPtr<ISettingsContainer>& SettingsContainer : SettingsContainers)
+            {
+                const FString ContainerFolder = IsCombined ? FSettingsManagerOperations::GetContainerFolder(Folder, SettingsContainer->GetName()) : Folder;
+                for (const FSettingsCategorySections& CategorySections : FSettingsManagerOperations::GetExportableSections(SettingsContainer, Filter))
+                {
+                    for (const TSharedPtr<ISettingsSection>& Section : CategorySections.Sections)
+                    {
+                        Sections.Add(FSettingsManagerOperations::MakeSectionFile(SettingsContainer, CategorySections.Category, Section,
+                            FSettingsManagerOperations::GetSectionFilePath(ContainerFolder, CategorySections.Category->GetName(), Section->GetName())));
+                    }
+                }
+            }
+        }
+        else
+        {
+            FSettingsImportData ImportData;
+            if (IsArchive)
+            {
+                Archive = FSettingsArchive::Open(Path);
+                if (!Archive.IsValid())
+                {
+                    return Fail(FString::Printf(TEXT("'%s' isn't a valid settings archive"), *Path));
+                }
+                ImportData.Archive = Archive;
+                ImportData.Source = Path;
+            }
+            else
+            {
+                ImportData = FSettingsManagerOperations::ScanImportDirectory(Folder);
+
+                // the sections of a folder exported from a single container could match the ones of other containers
+                if (IsCombined && ImportData.Containers.IsEmpty())
+                {
+                    return Fail(FString::Printf(TEXT("'%s' wasn't exported from every container, so it can't be imported into all of them"), *Folder));
+                }
+            }
+
+            for (const TSharedPtr<ISettingsContainer>& SettingsContainer : SettingsContainers)
+            {
+                for (const FSettingsCategorySections& CategorySections : FSettingsManagerOperations::GetImportableSections(SettingsContainer, ImportData, Filter))
+                {
+                    for (int SectionIndex = 0; SectionIndex < CategorySections.Sections.Num(); ++SectionIndex)
+                    {
+                        Sections.Add(FSettingsManagerOperations::MakeSectionFile(SettingsContainer, CategorySections.Category,
+                            CategorySections.Sections[SectionIndex], CategorySections.FilePaths[SectionIndex]));
+                    }
+                }
+            }
+        }
+
+        if (PresetKeys.IsSet())
+        {
+            Sections.RemoveAll([&PresetKeys](const FSettingsSectionFile& Section) { return !PresetKeys->Contains(Section.Key); });
+        }
+
+        // compiled once, and shared by every section
+        if (KeyFilter.IsValid())
+        {
+            for (FSettingsSectionFile& Section : Sections)
+            {
+                Section.KeyFilter = KeyFilter;
+            }
+        }
+
+        TArray<FText> Failures;
+        TArray<FSettingsSectionResult> SectionResults;
+        int64 NumBytes = 0;
+        if (IsForExport)
+        {
+            // the sections of every container are captured together and written in one pass
+            if (IsCombined && !IsArchive)
+            {
+                TArray<FName> ContainerNames;
+                for (const TSharedPtr<ISettingsContainer>& SettingsContainer : SettingsContainers)
+                {
+                    ContainerNames.Add(SettingsContainer->GetName());
+                }
+                if (!FSettingsManagerOperations::WriteContainersFile(Folder, ContainerNames))
+                {
+                    Failures.Add(FText::FromString(FPaths::Combine(Folder, FSettingsManagerOperations::ContainersFileName)));
+                }
+            }
+
+            TSet<FSettingsSectionKey> FailedKeys;
+            FSettingsExportTask ExportTask{ FSettingsManagerOperations::CaptureSections(Sections, Failures, &FailedKeys), IsArchive ? Path : FString() };
+            if (Incremental && !IsArchive)
+            {
+                ExportTask.SetIncremental(Folder);
+            }
+            ExportTask.Run();
+            Failures.Append(ExportTask.GetFailures());
+            SectionResults = ExportTask.GetSectionResults();
+            NumBytes = ExportTask.GetNumBytesWritten();
+
+            // sections that failed to capture anything never made it to the task, and neither did the ones without any key matching the key filter
+            TSet<FSettingsSectionKey> CapturedKeys;
+            for (const FSettingsSectionResult& SectionResult : SectionResults)
+            {
+                CapturedKeys.Add(SectionResult.Key);
+            }
+            for (const FSettingsSectionFile& Section : Sections)
+            {
+                if (!CapturedKeys.Contains(Section.Key))
+                {
+                    SectionResults.Add({ Section.Key, FailedKeys.Contains(Section.Key) ? ESettingsSectionStatus::Failed : ESettingsSectionStatus::Unchanged });
+                }
+            }
+        }
+        else
+        {
+            const FSettingsImportStats Stats = FSettingsManagerOperations::ImportSections(Sections, Failures, Archive.Get(),
+                Merge ? ESettingsImportMode::Merge : ESettingsImportMode::Overwrite);
+            if (Merge)
+            {
+                UE_LOG(LogSettingsManager, Display, TEXT("Merged %d sections with %d conflicting keys"), Stats.NumSectionsImported, Stats.NumConflicts);
+            }
+            SectionResults = Stats.SectionResults;
+            for (const FSettingsSectionResult& SectionResult : SectionResults)
+            {
+                NumBytes += SectionResult.NumBytes;
+            }
+        }
+
+        FSettingsManagerOperations::ReportResults(IsForExport ? TEXT("Export") : TEXT("Import"), SectionResults, NumBytes,
+            FPlatformTime::Seconds() - StartTime);
+
+        FillResult(Result, SectionResults, Failures, StartTime);
+        return Result;
+    }
+
+    /**
+     * SettingsManager.Export/Import Path=<Folder or Archive> [Container=Editor|All] [Preset=<Name>] [Include=<Patterns>] [Exclude=<Patterns>]
+     *     [IncludeKeys=<Patterns>] [ExcludeKeys=<Patterns>] [-Incremental] [-Merge]
+     */
+    void RunConsoleCommand(bool IsForExport, const TArray<FString>& Args)
+    {
+        const FString Params = FString::Join(Args, TEXT(" "));
+
+        FString Path;
+        FString ContainerName = TEXT("Editor");
+        FString PresetName;
+        FString IncludeList;
+        FString ExcludeList;
+        FString IncludeKeyList;
+        FString ExcludeKeyList;
+        FParse::Value(*Params, TEXT("Path="), Path);
+        FParse::Value(*Params, TEXT("Container="), ContainerName);
+        FParse::Value(*Params, TEXT("Preset="), PresetName, false);
+        FParse::Value(*Params, TEXT("Include="), IncludeList, false);
+        FParse::Value(*Params, TEXT("Exclude="), ExcludeList, false);
+        FParse::Value(*Params, TEXT("IncludeKeys="), IncludeKeyList, false);
+        FParse::Value(*Params, TEXT("ExcludeKeys="), ExcludeKeyList, false);
+
+        const FSettingsManagerResult Result = Run(IsForExport, Path, ContainerName, PresetName, IncludeList, ExcludeList, IncludeKeyList, ExcludeKeyList,
+            FParse::Param(*Params, TEXT("Incremental")), FParse::Param(*Params, TEXT("Merge")));
+        USettingsManagerLibrary::LogResult(IsForExport ? TEXT("Export") : TEXT("Import"), ContainerName, Result);
+    }
+
+    FAutoConsoleCommand ExportCommand(
+        TEXT("SettingsManager.Export"),
+        TEXT("Bulk exports settings. Path=<Folder or .uesettings archive> [Container=Editor|All] [Preset=<Name>] [Include=<Patterns>] [Exclude=<Patterns>] [IncludeKeys=<Patterns>] [ExcludeKeys=<Patterns>] [-Incremental]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { RunConsoleCommand(true, Args); }));
+
+    FAutoConsoleCommand ImportCommand(
+        TEXT("SettingsManager.Import"),
+        TEXT("Bulk imports settings. Path=<Folder or .uesettings archive> [Container=Editor|All] [Preset=<Name>] [Include=<Patterns>] [Exclude=<Patterns>] [IncludeKeys=<Patterns>] [ExcludeKeys=<Patterns>] [-Merge]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { RunConsoleCommand(false, Args); }));
+
+    FAutoConsoleCommand RollbackCommand(
+        TEXT("SettingsManager.Rollback"),
+        TEXT("Restores the sections snapshotted before an import. [Snapshot=<Name>], the newest snapshot by default"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+            {
+                FString SnapshotName;
+                FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("Snapshot="), SnapshotName);
+
+                const FSettingsManagerResult Result = USettingsManagerLibrary::RollbackSettings(SnapshotName);
+                USettingsManagerLibrary::LogResult(TEXT("Rollback"), SnapshotName.IsEmpty() ? TEXT("the newest snapshot") : SnapshotName, Result);
+            }));
+
+    FAutoConsoleCommand ListSnapshotsCommand(
+        TEXT("SettingsManager.ListSnapshots"),
+        TEXT("Lists the snapshots taken before imports, newest first."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                for (const FString& SnapshotName : USettingsManagerLibrary::GetSnapshots())
+                {
+                    UE_LOG(LogSettingsManager, Display, TEXT("%s"), *SnapshotName);
+                }
+            }));
+}
+
+const TCHAR* const USettingsManagerLibrary::AllContainers = TEXT("All");
+
+FSettingsManagerResult USettingsManagerLibrary::ExportSettings(const FString& Path, const FString& Container, const FString& Preset,
+    const FString& Include, const FString& Exclude, bool Incremental, const FString& IncludeKeys, const FString& ExcludeKeys)
+{
+    return Run(true, Path, Container, Preset, Include, Exclude, IncludeKeys, ExcludeKeys, Incremental, false);
+}
+
+FSettingsManagerResult USettingsManagerLibrary::ImportSettings(const FString& Path, const FString& Container, const FString& Preset,
+    const FString& Include, const FString& Exclude, const FString& IncludeKeys, const FString& ExcludeKeys, bool Merge)
+{
+    return Run(false, Path, Container, Preset, Include, Exclude, IncludeKeys, ExcludeKeys, false, Merge);
+}
+
+FSettingsManagerResult USettingsManagerLibrary::RollbackSettings(const FString& Snapshot)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    FSettingsManagerResult Result;
+
+    FString SnapshotName = Snapshot;
+    if (SnapshotName.IsEmpty())
+    {
+        const TArray<FString> SnapshotNames = FSettingsSnapshots::GetSnapshotNames();
+        if (SnapshotNames.IsEmpty())
+        {
+            Result.Errors.Add(TEXT("No snapshot to roll back to"));
+            ++Result.NumFailed;
+            return Result;
+        }
+        SnapshotName = SnapshotNames[0];
+    }
+
+    TArray<FSettingsSectionFile> Sections;
+    TArray<FText> Failures;
+    if (!FSettingsSnapshots::LoadSnapshot(SnapshotName, Sections, Failures))
+    {
+        Result.Errors.Add(FString::Printf(TEXT("Unknown snapshot '%s'"), *SnapshotName));
+        ++Result.NumFailed;
+        return Result;
+    }
+    // the sections that are no longer registered can't be restored
+    Result.NumFailed += Failures.Num();
+
+    // rolling back is an import like any other, so it's snapshotted too and can be rolled back in turn
+    const FSettingsImportStats Stats = FSettingsManagerOperations::ImportSections(Sections, Failures);
+    int64 NumBytes = 0;
+    for (const FSettingsSectionResult& SectionResult : Stats.SectionResults)
+    {
+        NumBytes += SectionResult.NumBytes;
+    }
+    FSettingsManagerOperations::ReportResults(TEXT("Rollback"), Stats.SectionResults, NumBytes, FPlatformTime::Seconds() - StartTime);
+
+    FillResult(Result, Stats.SectionResults, Failures, StartTime);
+    return Result;
+}
+
+TArray<FString> USettingsManagerLibrary::GetSnapshots()
+{
+    return FSettingsSnapshots::GetSnapshotNames();
+}
+
+void USettingsManagerLibrary::LogResult(const FString& Operation, const FString& Container, const FSettingsManagerResult& Result)
+{
+    for (const FString& Error : Result.Errors)
+    {
+        UE_LOG(LogSettingsManager, Error, TEXT("%s settings failed for %s"), *Operation, *Error);
+    }
+
+    int32 NumUnchanged = 0;
+    for (const FSettingsManagerSectionResult& Section : Result.Sections)
+    {
+        NumUnchanged += Section.Status == ESettingsManagerSectionStatus::Unchanged ? 1 : 0;
+    }
+
+    UE_LOG(LogSettingsManager, Display, TEXT("%s of %d sections from '%s' finished in %.1f ms with %d unchanged and %d failures"),
+        *Operation, Result.Sections.Num(), *Container, Result.ElapsedMilliseconds, NumUnchanged, Result.NumFailed);
+}
@@ -0,0 +1,1348 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsManagerOperations.h"
+
+#include "SettingsArchive.h"
+#include "SettingsSnapshots.h"
+#include "ISettingsCategory.h"
+#include "ISettingsContainer.h"
+#include "ISettingsModule.h"
+#include "ISettingsSection.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "String/ParseLines.h"
+#include "String/ParseTokens.h"
+
+DEFINE_LOG_CATEGORY(LogSettingsManager);
+
+static TAutoConsoleVariable<bool> CVarBatchedImport(
+    TEXT("SettingsManager.BatchedImport"),
+    true,
+    TEXT("If true, bulk imports save every section with config flushing suppressed, and then write each dirty config file once."));
+
+static TAutoConsoleVariable<bool> CVarSkipUnchangedSections(
+    TEXT("SettingsManager.SkipUnchangedSections"),
+    true,
+    TEXT("If true, bulk imports diff each section against its live state first, and leave alone the ones that wouldn't change."));
+
+static TAutoConsoleVariable<bool> CVarSnapshotBeforeImport(
+    TEXT("SettingsManager.SnapshotBeforeImport"),
+    true,
+    TEXT("If true, bulk imports snapshot every section they change right before changing it, so that SettingsManager.Rollback can restore them."));
+
+static TAutoConsoleVariable<int32> CVarSectionOrder(
+    TEXT("SettingsManager.SectionOrder"),
+    0,
+    TEXT("How the sections of a category are listed for export.\n")
+    TEXT(" 0: by display name\n")
+    TEXT(" 1: by internal name\n")
+    TEXT(" 2: by config file, then by display name"));
+
+static TAutoConsoleVariable<FString> CVarReportFolder(
+    TEXT("SettingsManager.ReportFolder"),
+    TEXT(""),
+    TEXT("If set, every bulk export or import writes a CSV report of the status, time and size of each section to this folder."));
+
+static TAutoConsoleVariable<int32> CVarMergeConflicts(
+    TEXT("SettingsManager.MergeConflicts"),
+    0,
+    TEXT("How merge imports resolve a key changed both locally and by the imported file, each of which is logged. A key without a default in the\n")
+    TEXT("config hierarchy counts as changed locally once it's set in the local config, since its default is only known to C++.\n")
+    TEXT(" 0: keep the local value (default)\n")
+    TEXT(" 1: take the imported value"));
+
+static TAutoConsoleVariable<bool> CVarCompressArchives(
+    TEXT("SettingsManager.CompressArchives"),
+    true,
+    TEXT("If true, the sections packed into a settings archive are zlib-compressed."));
+
+namespace
+{
+    /** Whether ISettingsSection::Save would end up in UObject::SaveConfig, whose write goes through GConfig and can therefore be deferred. */
+    bool CanDeferSave(const TSharedPtr<ISettingsSection>& Section)
+    {
+        const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+        return SettingsObject.IsValid() &&
+            SettingsObject->GetClass()->HasAnyClassFlags(CLASS_Config) &&
+            !SettingsObject->GetClass()->HasAnyClassFlags(CLASS_DefaultConfig | CLASS_GlobalUserConfig | CLASS_ProjectUserConfig);
+    }
+
+    /** Size of the file FFileHelper::SaveStringToFile writes for the text, which is ANSI if it can be and UTF-16 otherwise. */
+    int64 GetSavedSize(const FString& Contents)
+    {
+        return FCString::IsPureAnsi(*Contents) ? Contents.Len() : (Contents.Len() + 1) * static_cast<int64>(sizeof(UTF16CHAR));
+    }
+
+    /** (ini section, key) -> value, with the values of array keys joined with line breaks. */
+    using FFlatConfig = TMap<TPair<FString, FName>, FString>;
+
+    void FlattenIniSection(const FString& IniSectionName, const FConfigSection& IniSection, FFlatConfig& OutFlatConfig)
+    {
+        for (const TPair<FName, FConfigValue>& Pair : IniSection)
+        {
+            FString* Value = OutFlatConfig.Find({ IniSectionName, Pair.Key });
+            if (Value == nullptr)
+            {
+                OutFlatConfig.Add({ IniSectionName, Pair.Key }, Pair.Value.GetSavedValue());
+            }
+            else
+            {
+                *Value += TEXT('\n');
+                *Value += Pair.Value.GetSavedValue();
+            }
+        }
+    }
+
+    FFlatConfig FlattenConfig(const FString& Contents, const FString& FileName)
+    {
+        FConfigFile ConfigFile;
+        ConfigFile.ProcessInputFileContents(Contents, FileName);
+
+        FFlatConfig FlatConfig;
+        for (const TPair<FString, FConfigSection>& IniSection : ConfigFile)
+        {
+            FlattenIniSection(IniSection.Key, IniSection.Value, FlatConfig);
+        }
+        return FlatConfig;
+    }
+
+    /**
+     * The engine and project defaults of config files, i.e. their hierarchies without the saved local layer, each loaded once.
+     * A returned config is only valid until the next one is loaded.
+     */
+    class FDefaultConfigs
+    {
+    public:
+        const FConfigFile& Get(const FString& ConfigName)
+        {
+            const FString BaseName = FPaths::GetBaseFilename(ConfigName);
+            if (const FConfigFile* DefaultConfig = Configs.Find(BaseName))
+            {
+                return *DefaultConfig;
+            }
+
+            TRACE_CPUPROFILER_EVENT_SCOPE(FDefaultConfigs::Load);
+            FConfigFile& DefaultConfig = Configs.Add(BaseName);
+            FConfigCacheIni::LoadLocalIniFile(DefaultConfig, *BaseName, true, nullptr, true);
+            return DefaultConfig;
+        }
+
+    private:
+        TMap<FString, FConfigFile> Configs;
+    };
+
+    /** Key of a "Key=Value" ini line, without the operator of array entries such as "+Key=Value". */
+    FName GetLineKey(FStringView Line)
+    {
+        int32 EqualsIndex;
+        if (!Line.FindChar(TEXT('='), EqualsIndex))
+        {
+            return NAME_None;
+        }
+
+        FStringView Key = Line.Left(EqualsIndex).TrimStartAndEnd();
+        if (!Key.IsEmpty() && FCString::Strchr(TEXT("+-.!@*^"), Key[0]) != nullptr)
+        {
+            Key.RightChopInline(1);
+        }
+        return FName(Key.Len(), Key.GetData());
+    }
+
+    bool IsSetInConfig(const FConfigFile* Config, const FString& IniSectionName, FName Key)
+    {
+        const FConfigSection* IniSection = Config != nullptr ? Config->FindSection(IniSectionName) : nullptr;
+        return IniSection != nullptr && IniSection->Find(Key) != nullptr;
+    }
+
+    /**
+     * Three-way merges the keys of a section into the ini text of the ones to change, which is empty if none would.
+     * Returns false for sections without a config object, whose defaults are unknown, and for sections with a custom importer,
+     * which may not expect a file holding only some of the keys.
+     */
+    bool MergeSection(const FSettingsSectionFile& Section, const FString& IncomingContents, FDefaultConfigs& DefaultConfigs, FString& OutContents,
+        int32& OutNumConflicts)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(MergeSection);
+
+        OutContents.Reset();
+
+        const TWeakObjectPtr<UObject> SettingsObject = Section.Section->GetSettingsObject();
+        if (Section.Section->OnImport().IsBound() || !SettingsObject.IsValid() || !SettingsObject->GetClass()->HasAnyClassFlags(CLASS_Config))
+        {
+            return false;
+        }
+
+        FString LocalContents;
+        FSettingsManagerOperations::CaptureSection(Section.Section, Section.FilePath, LocalContents, Section.KeyFilter.Get());
+
+        // every side is flattened into hash maps, so each key is merged with a single lookup per side
+        const FFlatConfig LocalConfig = FlattenConfig(LocalContents, Section.FilePath);
+        const FFlatConfig IncomingConfig = FlattenConfig(IncomingContents, Section.FilePath);
+
+        // only the ini sections the imported file sets are flattened out of the whole default config
+        const FString ConfigName = SettingsObject->GetClass()->GetConfigName();
+        const FConfigFile& DefaultConfig = DefaultConfigs.Get(ConfigName);
+        FFlatConfig BaseConfig;
+        TSet<FString> BaseIniSectionNames;
+        for (const auto& [IniKey, IncomingValue] : IncomingConfig)
+        {
+            bool IsAlreadyFlattened;
+            BaseIniSectionNames.Add(IniKey.Key, &IsAlreadyFlattened);
+            if (const FConfigSection* IniSection = IsAlreadyFlattened ? nullptr : DefaultConfig.FindSection(IniKey.Key))
+            {
+                FlattenIniSection(IniKey.Key, *IniSection, BaseConfig);
+            }
+        }
+
+        // the config the object was loaded from, which only holds a key missing from the defaults if it was set locally
+        const FConfigFile* LoadedConfig = GConfig->Find(ConfigName);
+
+        const bool TakeIncomingConflicts = CVarMergeConflicts.GetValueOnGameThread() != 0;
+        TMap<FString, FString> IniSectionLines;
+        for (const auto& [IniKey, IncomingValue] : IncomingConfig)
+        {
+            const FString* LocalValue = LocalConfig.Find(IniKey);
+            if (LocalValue != nullptr && LocalValue->Equals(IncomingValue, ESearchCase::CaseSensitive))
+            {
+                continue;
+            }
+
+            // a key the imported file leaves at its default keeps its local value, and one left at its default locally takes the imported value
+            const FString* BaseValue = BaseConfig.Find(IniKey);
+            if (BaseValue != nullptr && BaseValue->Equals(IncomingValue, ESearchCase::CaseSensitive))
+            {
+                continue;
+            }
+
+            // a key without a default in the config hierarchy has its C++ default as its base, which the local value still is unless it was set in the config
+            const bool IsChangedLocally = LocalValue != nullptr && (BaseValue != nullptr ?
+                !BaseValue->Equals(*LocalValue, ESearchCase::CaseSensitive) :
+                IsSetInConfig(LoadedConfig, IniKey.Key, IniKey.Value));
+            if (IsChangedLocally)
+            {
+                ++OutNumConflicts;
+                UE_LOG(LogSettingsManager, Display, TEXT("%s: [%s] %s is changed both locally and by the imported file, %s"),
+                    *Section.Key.ToString(), *IniKey.Key, *IniKey.Value.ToString(),
+                    TakeIncomingConflicts ? TEXT("taking the imported value") : TEXT("keeping the local value"));
+                if (!TakeIncomingConflicts)
+                {
+                    continue;
+                }
+            }
+
+            // array keys were joined with line breaks, and are written back one entry per line
+            FString& Lines = IniSectionLines.FindOrAdd(IniKey.Key);
+            const FString KeyString = IniKey.Value.ToString();
+            UE::String::ParseTokens(IncomingValue, TEXT('\n'), [&Lines, &KeyString](FStringView Value)
+                {
+                    Lines += KeyString;
+                    Lines += TEXT('=');
+                    Lines.Append(Value.GetData(), Value.Len());
+                    Lines += LINE_TERMINATOR;
+                });
+        }
+
+        for (const auto& [IniSectionName, Lines] : IniSectionLines)
+        {
+            OutContents += FString::Printf(TEXT("[%s]") LINE_TERMINATOR, *IniSectionName);
+            OutContents += Lines;
+            OutContents += LINE_TERMINATOR;
+        }
+        return true;
+    }
+}
+
+FString FSettingsSectionKey::ToString() const
+{
+    return FString::Printf(TEXT("%s/%s/%s"), *ContainerName.ToString(), *CategoryName.ToString(), *SectionName.ToString());
+}
+
+FSettingsSectionFilter FSettingsSectionFilter::Parse(const FString& IncludeList, const FString& ExcludeList)
+{
+    FSettingsSectionFilter Filter;
+    IncludeList.ParseIntoArray(Filter.Include, TEXT(","));
+    ExcludeList.ParseIntoArray(Filter.Exclude, TEXT(","));
+    return Filter;
+}
+
+bool FSettingsSectionFilter::Matches(FName CategoryName, FName SectionName) const
+{
+    const FString CategoryString = CategoryName.ToString();
+    const FString Path = FString::Printf(TEXT("%s/%s"), *CategoryString, *SectionName.ToString());
+    const auto MatchesAny = [&CategoryString, &Path](const TArray<FString>& Patterns)
+        {
+            return Patterns.ContainsByPredicate([&CategoryString, &Path](const FString& Pattern)
+                {
+                    return Path.MatchesWildcard(Pattern) || (!Pattern.Contains(TEXT("/")) && CategoryString.MatchesWildcard(Pattern));
+                });
+        };
+
+    return (Include.Num() == 0 || MatchesAny(Include)) && !MatchesAny(Exclude);
+}
+
+TSharedPtr<const FSettingsKeyFilter> FSettingsKeyFilter::Parse(const FString& IncludeList, const FString& ExcludeList)
+{
+    TArray<FString> IncludePatterns;
+    TArray<FString> ExcludePatterns;
+    IncludeList.ParseIntoArray(IncludePatterns, TEXT(","));
+    ExcludeList.ParseIntoArray(ExcludePatterns, TEXT(","));
+    if (IncludePatterns.IsEmpty() && ExcludePatterns.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    const TSharedRef<FSettingsKeyFilter> KeyFilter = MakeShared<FSettingsKeyFilter>();
+    for (const FString& Pattern : IncludePatterns)
+    {
+        KeyFilter->Include.Add(Pattern.TrimStartAndEnd());
+    }
+    for (const FString& Pattern : ExcludePatterns)
+    {
+        KeyFilter->Exclude.Add(Pattern.TrimStartAndEnd());
+    }
+    return KeyFilter;
+}
+
+void FSettingsKeyFilter::FPatterns::Add(const FString& Pattern)
+{
+    const bool IsQualified = Pattern.Contains(TEXT(":"));
+    if (Pattern.Contains(TEXT("*")) || Pattern.Contains(TEXT("?")))
+    {
+        (IsQualified ? QualifiedWildcards : KeyWildcards).Add(Pattern);
+    }
+    else if (IsQualified)
+    {
+        QualifiedKeys.Add(Pattern);
+    }
+    else
+    {
+        Keys.Add(FName{ *Pattern });
+    }
+}
+
+bool FSettingsKeyFilter::FPatterns::IsEmpty() const
+{
+    return Keys.IsEmpty() && QualifiedKeys.IsEmpty() && KeyWildcards.IsEmpty() && QualifiedWildcards.IsEmpty();
+}
+
+bool FSettingsKeyFilter::FPatterns::Matches(const FString& IniSectionName, FName Key) const
+{
+    // most patterns are plain key names, which only cost a lookup
+    if (Keys.Contains(Key))
+    {
+        return true;
+    }
+
+    const bool HasQualified = !QualifiedKeys.IsEmpty() || !QualifiedWildcards.IsEmpty();
+    if (KeyWildcards.IsEmpty() && !HasQualified)
+    {
+        return false;
+    }
+
+    const FString KeyString = Key.ToString();
+    if (KeyWildcards.ContainsByPredicate([&KeyString](const FString& Pattern) { return KeyString.MatchesWildcard(Pattern); }))
+    {
+        return true;
+    }
+    if (!HasQualified)
+    {
+        return false;
+    }
+
+    const FString QualifiedKey = FString::Printf(TEXT("%s:%s"), *IniSectionName, *KeyString);
+    return QualifiedKeys.Contains(QualifiedKey) ||
+        QualifiedWildcards.ContainsByPredicate([&QualifiedKey](const FString& Pattern) { return QualifiedKey.MatchesWildcard(Pattern); });
+}
+
+bool FSettingsKeyFilter::Matches(const FString& IniSectionName, FName Key) const
+{
+    return (Include.IsEmpty() || Include.Matches(IniSectionName, Key)) && !Exclude.Matches(IniSectionName, Key);
+}
+
+FString FSettingsKeyFilter::FilterContents(const FString& Contents) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsKeyFilter::FilterContents);
+
+    FString Result;
+    Result.Reserve(Contents.Len());
+
+    // an ini section's header is only written once one of its keys matches, so the sections left without any are dropped
+    FString IniSectionName;
+    bool IsHeaderWritten = false;
+    UE::String::ParseLines(Contents, [this, &Result, &IniSectionName, &IsHeaderWritten](FStringView Line)
+        {
+            const FStringView TrimmedLine = Line.TrimStartAndEnd();
+            if (TrimmedLine.StartsWith(TEXT('[')) && TrimmedLine.EndsWith(TEXT(']')))
+            {
+                IniSectionName = FString(TrimmedLine.Mid(1, TrimmedLine.Len() - 2));
+                IsHeaderWritten = false;
+                return;
+            }
+
+            const FName Key = GetLineKey(TrimmedLine);
+            if (Key.IsNone() || !Matches(IniSectionName, Key))
+            {
+                return;
+            }
+
+            if (!IsHeaderWritten)
+            {
+                if (!Result.IsEmpty())
+                {
+                    Result += LINE_TERMINATOR;
+                }
+                Result += FString::Printf(TEXT("[%s]") LINE_TERMINATOR, *IniSectionName);
+                IsHeaderWritten = true;
+            }
+            Result.Append(TrimmedLine.GetData(), TrimmedLine.Len());
+            Result += LINE_TERMINATOR;
+        });
+
+    return Result;
+}
+
+FSettingsCategorySections FSettingsManagerOperations::GetExportableSections(const TSharedPtr<ISettingsCategory>& Category,
+    const FSettingsSectionFilter& Filter)
+{
+    // the keys are built once per section, so sorting only compares plain strings instead of collating FTexts
+    struct FSortableSection
+    {
+        FString PrimaryKey;
+        FString SecondaryKey;
+        TSharedPtr<ISettingsSection> Section;
+
+        bool operator<(const FSortableSection& Other) const
+        {
+            const int32 Result = PrimaryKey.Compare(Other.PrimaryKey, ESearchCase::CaseSensitive);
+            return Result != 0 ? Result < 0 : SecondaryKey.Compare(Other.SecondaryKey, ESearchCase::CaseSensitive) < 0;
+        }
+    };
+
+    const int32 SectionOrder = CVarSectionOrder.GetValueOnGameThread();
+    const auto MakeSortableSection = [SectionOrder](const TSharedPtr<ISettingsSection>& Section)
+        {
+            FSortableSection SortableSection{ {}, Section->GetDisplayName().ToString().ToLower(), Section };
+            if (SectionOrder == 1)
+            {
+                SortableSection.PrimaryKey = Section->GetName().ToString().ToLower();
+            }
+            else if (SectionOrder == 2)
+            {
+                // sections without a config object go last
+                const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+                SortableSection.PrimaryKey = SettingsObject.IsValid() ?
+                    FPaths::GetCleanFilename(SettingsObject->GetClass()->GetConfigName()).ToLower() :
+                    FString(TEXT("\uffff"));
+            }
+            return SortableSection;
+        };
+
+    FSettingsCategorySections CategorySections;
+    CategorySections.Category = Category;
+
+    TArray<TSharedPtr<ISettingsSection>> SettingsSections;
+    Category->GetSections(SettingsSections);
+
+    TArray<FSortableSection> SortableSections;
+    SortableSections.Reserve(SettingsSections.Num());
+    for (const TSharedPtr<ISettingsSection>& Section : SettingsSections)
+    {
+        if (Section.IsValid() && Section->CanExport() && Filter.Matches(Category->GetName(), Section->GetName()))
+        {
+            SortableSections.Add(MakeSortableSection(Section));
+        }
+    }
+    SortableSections.Sort();
+
+    CategorySections.Sections.Reserve(SortableSections.Num());
+    for (FSortableSection& SortableSection : SortableSections)
+    {
+        CategorySections.Sections.Add(MoveTemp(SortableSection.Section));
+    }
+
+    return CategorySections;
+}
+
+TArray<FSettingsCategorySections> FSettingsManagerOperations::GetExportableSections(const TSharedPtr<ISettingsContainer>& Container,
+    const FSettingsSectionFilter& Filter)
+{
+    TArray<FSettingsCategorySections> Result;
+
+    TArray<TSharedPtr<ISettingsCategory>> SettingsCategories;
+    Container->GetCategories(SettingsCategories);
+    Result.Reserve(SettingsCategories.Num());
+    for (const TSharedPtr<ISettingsCategory>& Category : SettingsCategories)
+    {
+        Result.Add(GetExportableSections(Category, Filter));
+    }
+
+    return Result;
+}
+
+TArray<FSettingsCategorySections> FSettingsManagerOperations::GetImportableSections(const TSharedPtr<ISettingsContainer>& Container,
+    const FSettingsImportData& ImportData, const FSettingsSectionFilter& Filter)
+{
+    if (!ImportData.Containers.IsEmpty())
+    {
+        const TSharedPtr<const FSettingsImportData> ContainerData = ImportData.Containers.FindRef(Container->GetName());
+        return ContainerData.IsValid() ? GetImportableSections(Container, *ContainerData, Filter) : TArray<FSettingsCategorySections>();
+    }
+
+    TArray<FSettingsCategorySections> Result;
+    TMap<FName, int32> CategoryIndices;
+
+    const auto AddSection = [&Container, &Filter, &Result, &CategoryIndices](FName CategoryName, FName SectionName, const FString& FilePath)
+        {
+            int32* CategoryIndex = CategoryIndices.Find(CategoryName);
+            if (CategoryIndex == nullptr)
+            {
+                const TSharedPtr<ISettingsCategory> Category = Container->GetCategory(CategoryName);
+                CategoryIndex = &CategoryIndices.Add(CategoryName, Category.IsValid() ? Result.Num() : INDEX_NONE);
+                if (Category.IsValid())
+                {
+                    Result.AddDefaulted_GetRef().Category = Category;
+                }
+            }
+
+            if (*CategoryIndex == INDEX_NONE)
+            {
+                return;
+            }
+
+            FSettingsCategorySections& CategorySections = Result[*CategoryIndex];
+            const TSharedPtr<ISettingsSection> Section = CategorySections.Category->GetSection(SectionName);
+            if (Section.IsValid() && Section->CanImport() && Filter.Matches(CategoryName, SectionName))
+            {
+                CategorySections.Sections.Add(Section);
+                CategorySections.FilePaths.Add(FilePath);
+            }
+        };
+
+    if (ImportData.Archive.IsValid())
+    {
+        for (const FSettingsSectionKey& Key : ImportData.Archive->GetKeys())
+        {
+            if (Key.ContainerName == Container->GetName())
+            {
+                AddSection(Key.CategoryName, Key.SectionName, ImportData.Archive->GetFilePath());
+            }
+        }
+    }
+    else
+    {
+        for (const auto& [CategoryName, Sections] : ImportData.Files)
+        {
+            for (const auto& [SectionName, FilePath] : Sections)
+            {
+                AddSection(CategoryName, SectionName, FilePath);
+            }
+        }
+    }
+
+    return Result;
+}
+
+const TCHAR* const FSettingsManagerOperations::ContainersFileName = TEXT("SettingsContainers.txt");
+
+TArray<TSharedPtr<ISettingsContainer>> FSettingsManagerOperations::GetContainers()
+{
+    TArray<TSharedPtr<ISettingsContainer>> Containers;
+
+    ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
+    if (SettingsModule == nullptr)
+    {
+        return Containers;
+    }
+
+    // the built-in containers come first, in the order of the editor's own menus, and the ones registered by other tools after them by name
+    TArray<FName> ContainerNames;
+    SettingsModule->GetContainerNames(ContainerNames);
+    const auto GetBuiltInRank = [](FName ContainerName)
+        {
+            return ContainerName == TEXT("Editor") ? 0 : ContainerName == TEXT("Project") ? 1 : 2;
+        };
+    ContainerNames.Sort([&GetBuiltInRank](FName A, FName B)
+        {
+            const int32 RankA = GetBuiltInRank(A);
+            const int32 RankB = GetBuiltInRank(B);
+            return RankA != RankB ? RankA < RankB : A.LexicalLess(B);
+        });
+    for (const FName& ContainerName : ContainerNames)
+    {
+        if (const TSharedPtr<ISettingsContainer> Container = SettingsModule->GetContainer(ContainerName);
+            Container.IsValid())
+        {
+            Containers.Add(Container);
+        }
+    }
+    return Containers;
+}
+
+FString FSettingsManagerOperations::GetContainerFolder(const FString& Root, FName ContainerName)
+{
+    return FPaths::Combine(Root, ContainerName.ToString());
+}
+
+bool FSettingsManagerOperations::WriteContainersFile(const FString& Root, const TArray<FName>& ContainerNames)
+{
+    TArray<FString> Lines;
+    for (const FName& ContainerName : ContainerNames)
+    {
+        Lines.Add(ContainerName.ToString());
+    }
+    return FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Root) &&
+        FFileHelper::SaveStringArrayToFile(Lines, *FPaths::Combine(Root, ContainersFileName));
+}
+
+FSettingsImportData FSettingsManagerOperations::ScanImportDirectory(const FString& Folder)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // a combined export has one subfolder per container, which are scanned side by side
+    if (TArray<FString> ContainerNames;
+        FFileHelper::LoadFileToStringArray(ContainerNames, *FPaths::Combine(Folder, ContainersFileName)))
+    {
+        ContainerNames.RemoveAll([](const FString& ContainerName) { return ContainerName.TrimStartAndEnd().IsEmpty(); });
+
+        TArray<FSettingsImportData> ContainersData;
+        ContainersData.SetNum(ContainerNames.Num());
+        ParallelFor(ContainerNames.Num(), [&Folder, &ContainerNames, &ContainersData](int32 Index)
+            {
+                ContainersData[Index] = ScanImportDirectory(GetContainerFolder(Folder, FName{ *ContainerNames[Index].TrimStartAndEnd() }));
+            });
+
+        FSettingsImportData ImportData;
+        ImportData.Source = Folder;
+        for (int32 Index = 0; Index < ContainerNames.Num(); ++Index)
+        {
+            ImportData.InvalidFiles.Append(ContainersData[Index].InvalidFiles);
+            ImportData.Containers.Add(FName{ *ContainerNames[Index].TrimStartAndEnd() }, MakeShared<const FSettingsImportData>(MoveTemp(ContainersData[Index])));
+        }
+        return ImportData;
+    }
+
+    TArray<FString> CategoryFolders;
+    PlatformFile.IterateDirectory(*Folder, [&CategoryFolders](const TCHAR* Directory, bool bIsDirectory)
+        {
+            if (bIsDirectory)
+            {
+                CategoryFolders.Emplace(Directory);
+            }
+            return true;
+        });
+
+    struct FScannedCategory
+    {
+        TMap<FName, FString> Files;
+        TArray<FString> InvalidFiles;
+    };
+    TArray<FScannedCategory> ScannedCategories;
+    ScannedCategories.SetNum(CategoryFolders.Num());
+
+    // listing and reading the files is what's slow on a remote file system, so each category is scanned by its own task
+    ParallelFor(CategoryFolders.Num(), [&PlatformFile, &CategoryFolders, &ScannedCategories](int32 Index)
+        {
+            FScannedCategory& ScannedCategory = ScannedCategories[Index];
+            PlatformFile.IterateDirectory(*CategoryFolders[Index], [&ScannedCategory](const TCHAR* FileName, bool bIsDirectory)
+                {
+                    if (bIsDirectory || FPaths::GetExtension(FileName) != TEXT("ini"))
+                    {
+                        return true;
+                    }
+
+                    FString Contents;
+                    FConfigFile ConfigFile;
+                    if (FFileHelper::LoadFileToString(Contents, FileName))
+                    {
+                        ConfigFile.ProcessInputFileContents(Contents, FileName);
+                    }
+
+                    if (ConfigFile.Num() > 0)
+                    {
+                        ScannedCategory.Files.Add(FName{ *FPaths::GetBaseFilename(FileName) }, FileName);
+                    }
+                    else
+                    {
+                        ScannedCategory.InvalidFiles.Emplace(FileName);
+                    }
+                    return true;
+                });
+        });
+
+    FSettingsImportData ImportData;
+    ImportData.Source = Folder;
+    for (int32 Index = 0; Index < CategoryFolders.Num(); ++Index)
+    {
+        ImportData.Files.Add(FName{ *FPaths::GetPathLeaf(CategoryFolders[Index]) }, MoveTemp(ScannedCategories[Index].Files));
+        ImportData.InvalidFiles.Append(MoveTemp(ScannedCategories[Index].InvalidFiles));
+    }
+
+    return ImportData;
+}
+
+void FSettingsManagerOperations::ScanImportDirectoryAsync(const FString& Folder, TSharedPtr<const FSettingsImportData> PreviousScan,
+    TUniqueFunction<void(const FSettingsImportManifest&)> OnScanned)
+{
+    Async(EAsyncExecution::ThreadPool, [Folder, PreviousScan = MoveTemp(PreviousScan), OnScanned = MoveTemp(OnScanned)]() mutable
+        {
+            // stamped before scanning, so that files changing during the scan make the next comparison fail
+            const FSettingsSourceStamp SourceStamp = GetSourceStamp(Folder);
+
+            // listing the folder is enough to tell that nothing was added, removed or modified, without reading the files again
+            TSharedPtr<const FSettingsImportData> ScannedData;
+            if (PreviousScan.IsValid() && !PreviousScan->Archive.IsValid() && FPaths::IsSamePath(PreviousScan->Source, Folder) &&
+                PreviousScan->SourceStamp == SourceStamp)
+            {
+                ScannedData = MoveTemp(PreviousScan);
+            }
+            else
+            {
+                FSettingsImportData ImportData = ScanImportDirectory(Folder);
+                ImportData.SourceStamp = SourceStamp;
+                ScannedData = MakeShared<const FSettingsImportData>(MoveTemp(ImportData));
+            }
+            const FSettingsImportManifest Manifest = ScannedData.ToSharedRef();
+
+            AsyncTask(ENamedThreads::GameThread, [Manifest, OnScanned = MoveTemp(OnScanned)]()
+                {
+                    OnScanned(Manifest);
+                });
+        });
+}
+
+FSettingsSourceStamp FSettingsManagerOperations::GetSourceStamp(const FString& Source)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsManagerOperations::GetSourceStamp);
+
+    FSettingsSourceStamp Stamp;
+    const auto AddFile = [&Stamp](const FFileStatData& StatData)
+        {
+            Stamp.NewestTimeStamp = FMath::Max(Stamp.NewestTimeStamp, StatData.ModificationTime);
+            Stamp.TotalSize += StatData.FileSize;
+            ++Stamp.NumFiles;
+        };
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (const FFileStatData StatData = PlatformFile.GetStatData(*Source); StatData.bIsValid && !StatData.bIsDirectory)
+    {
+        AddFile(StatData);
+        return Stamp;
+    }
+
+    // files added or removed change the count even when their timestamps are older than the newest one
+    PlatformFile.IterateDirectoryStatRecursively(*Source, [&AddFile](const TCHAR* FileName, const FFileStatData& StatData)
+        {
+            if (!StatData.bIsDirectory)
+            {
+                AddFile(StatData);
+            }
+            return true;
+        });
+    return Stamp;
+}
+
+FString FSettingsManagerOperations::GetSectionFilePath(const FString& Folder, FName CategoryName, FName SectionName)
+{
+    return FPaths::RemoveDuplicateSlashes(FString::Printf(TEXT("%s/%s/%s.ini"), *Folder, *CategoryName.ToString(), *SectionName.ToString()));
+}
+
+FSettingsSectionFile FSettingsManagerOperations::MakeSectionFile(const TSharedPtr<ISettingsContainer>& Container, const TSharedPtr<ISettingsCategory>& Category,
+    const TSharedPtr<ISettingsSection>& Section, const FString& FilePath)
+{
+    return {
+        Section,
+        { Container->GetName(), Category->GetName(), Section->GetName() },
+        FilePath,
+        FText::Format(FText::FromString("{0}/{1}"), Category->GetDisplayName(), Section->GetDisplayName())
+    };
+}
+
+bool FSettingsManagerOperations::CaptureSection(const TSharedPtr<ISettingsSection>& Section, const FString& FileName, FString& OutContents,
+    const FSettingsKeyFilter* KeyFilter)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsManagerOperations::CaptureSection);
+
+    OutContents.Reset();
+
+    // a bound exporter is what ISettingsSection::Export runs instead of saving the config object, so it's never bypassed
+    if (const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+        !Section->OnExport().IsBound() && SettingsObject.IsValid() && SettingsObject->GetClass()->HasAnyClassFlags(CLASS_Config))
+    {
+        // what ISettingsSection::Export does, but into a throwaway config cache that is never flushed to the disk
+        FConfigCacheIni TempConfig(EConfigCacheType::Temporary);
+        TempConfig.Add(FileName, FConfigFile{});
+        SettingsObject->SaveConfig(CPF_Config, *FileName, &TempConfig);
+
+        TArray<FString> IniSectionNames;
+        TempConfig.GetSectionNames(FileName, IniSectionNames);
+        for (const FString& IniSectionName : IniSectionNames)
+        {
+            TArray<FString> Lines;
+            TempConfig.GetSection(*IniSectionName, Lines, FileName);
+            if (KeyFilter != nullptr)
+            {
+                Lines.RemoveAll([KeyFilter, &IniSectionName](const FString& Line) { return !KeyFilter->Matches(IniSectionName, GetLineKey(Line)); });
+                if (Lines.IsEmpty())
+                {
+                    continue;
+                }
+            }
+
+            OutContents += FString::Printf(TEXT("[%s]") LINE_TERMINATOR, *IniSectionName);
+            for (const FString& Line : Lines)
+            {
+                OutContents += Line;
+                OutContents += LINE_TERMINATOR;
+            }
+            OutContents += LINE_TERMINATOR;
+        }
+
+        return true;
+    }
+
+    // sections with a custom exporter or without a config object can only write to a file, so let them write a local temporary one and read it back
+    const FString TempFileName = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("SettingsManager"), TEXT(".ini"));
+    const bool Exported = Section->Export(TempFileName);
+    FFileHelper::LoadFileToString(OutContents, *TempFileName);
+    IFileManager::Get().Delete(*TempFileName, false, false, true);
+    if (KeyFilter != nullptr)
+    {
+        OutContents = KeyFilter->FilterContents(OutContents);
+    }
+
+    return Exported;
+}
+
+TArray<FCapturedSettingsSection> FSettingsManagerOperations::CaptureSections(const TArray<FSettingsSectionFile>& Sections, TArray<FText>& OutFailures,
+    TSet<FSettingsSectionKey>* OutFailedKeys)
+{
+    TArray<FCapturedSettingsSection> CapturedSections;
+    CapturedSections.Reserve(Sections.Num());
+
+    for (const FSettingsSectionFile& Section : Sections)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Section.Key.ToString());
+        const double StartTime = FPlatformTime::Seconds();
+
+        FCapturedSettingsSection CapturedSection{ Section.Key, Section.DisplayName, Section.FilePath };
+        if (!CaptureSection(Section.Section, Section.FilePath, CapturedSection.Contents, Section.KeyFilter.Get()))
+        {
+            OutFailures.Add(Section.DisplayName);
+            if (OutFailedKeys != nullptr)
+            {
+                OutFailedKeys->Add(Section.Key);
+            }
+        }
+        CapturedSection.CaptureSeconds = FPlatformTime::Seconds() - StartTime;
+
+        if (!CapturedSection.Contents.IsEmpty())
+        {
+            CapturedSections.Add(MoveTemp(CapturedSection));
+        }
+    }
+
+    return CapturedSections;
+}
+
+bool FSettingsManagerOperations::ImportSectionContents(const TSharedPtr<ISettingsSection>& Section, const FString& Contents, const FString& VirtualFileName)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsManagerOperations::ImportSectionContents);
+
+    // a bound importer is what ISettingsSection::Import runs instead of loading the config object, so it's never bypassed
+    if (const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+        !Section->OnImport().IsBound() && SettingsObject.IsValid() && SettingsObject->GetClass()->HasAnyClassFlags(CLASS_Config))
+    {
+        // what ISettingsSection::Import does, but from a config file that only ever exists in GConfig
+        FConfigFile ConfigFile;
+        ConfigFile.ProcessInputFileContents(Contents, VirtualFileName);
+        GConfig->Add(VirtualFileName, ConfigFile);
+        SettingsObject->LoadConfig(SettingsObject->GetClass(), *VirtualFileName, UE::LCPF_PropagateToInstances);
+        GConfig->Remove(VirtualFileName);
+
+        return true;
+    }
+
+    // sections with a custom importer or without a config object can only read from a file, so give them a local temporary one
+    const FString TempFileName = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("SettingsManager"), TEXT(".ini"));
+    const bool Imported = FFileHelper::SaveStringToFile(Contents, *TempFileName) && Section->Import(TempFileName);
+    IFileManager::Get().Delete(*TempFileName, false, false, true);
+
+    return Imported;
+}
+
+bool FSettingsManagerOperations::ReadSectionContents(const FSettingsSectionFile& Section, const FSettingsArchive* Archive, FString& OutContents)
+{
+    if (!(Archive != nullptr ? Archive->ReadSection(Section.Key, OutContents) : FFileHelper::LoadFileToString(OutContents, *Section.FilePath)))
+    {
+        return false;
+    }
+
+    if (Section.KeyFilter.IsValid())
+    {
+        OutContents = Section.KeyFilter->FilterContents(OutContents);
+    }
+    return true;
+}
+
+bool FSettingsManagerOperations::DiffSection(const FSettingsSectionFile& Section, const FString& IncomingContents, TArray<FSettingsKeyDiff>& OutDiffs)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsManagerOperations::DiffSection);
+
+    OutDiffs.Reset();
+
+    FString CurrentContents;
+    if (!CaptureSection(Section.Section, Section.FilePath, CurrentContents, Section.KeyFilter.Get()) && CurrentContents.IsEmpty())
+    {
+        return false;
+    }
+
+    // both sides are flattened into hash maps, so each key is compared with a single lookup. Only the incoming keys are compared,
+    // since loading the imported file leaves the keys it doesn't set as they are
+    const FFlatConfig CurrentConfig = FlattenConfig(CurrentContents, Section.FilePath);
+    const FFlatConfig IncomingConfig = FlattenConfig(IncomingContents, Section.FilePath);
+
+    for (const auto& [IniKey, IncomingValue] : IncomingConfig)
+    {
+        const FString* CurrentValue = CurrentConfig.Find(IniKey);
+        if (CurrentValue == nullptr || !CurrentValue->Equals(IncomingValue, ESearchCase::CaseSensitive))
+        {
+            OutDiffs.Add({ IniKey.Key, IniKey.Value, CurrentValue != nullptr ? TOptional<FString>(*CurrentValue) : NullOpt, IncomingValue });
+        }
+    }
+
+    return true;
+}
+
+FSettingsImportStats FSettingsManagerOperations::ImportSections(const TArray<FSettingsSectionFile>& Sections, TArray<FText>& OutFailures,
+    const FSettingsArchive* Archive, ESettingsImportMode Mode)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsManagerOperations::ImportSections);
+
+    const double StartTime = FPlatformTime::Seconds();
+    FSettingsImportStats Stats;
+
+    Stats.SectionResults.Reserve(Sections.Num());
+    for (const FSettingsSectionFile& Section : Sections)
+    {
+        Stats.SectionResults.Add({ Section.Key, ESettingsSectionStatus::Failed });
+    }
+
+    const bool SkipUnchanged = CVarSkipUnchangedSections.GetValueOnGameThread();
+    const bool IsMerge = Mode == ESettingsImportMode::Merge;
+    FDefaultConfigs DefaultConfigs;
+    TOptional<FSettingsSnapshots::FBuilder> Snapshot;
+    if (CVarSnapshotBeforeImport.GetValueOnGameThread())
+    {
+        Snapshot.Emplace();
+    }
+    const auto Import = [Archive, SkipUnchanged, IsMerge, &DefaultConfigs, &Stats, &Snapshot](const FSettingsSectionFile& Section, int64& OutNumBytes)
+        {
+            // a key filter or a merge only applies to the ini text, so such sections are never imported straight from their file
+            const bool IsFromFile = Archive == nullptr && !Section.KeyFilter.IsValid() && !IsMerge;
+
+            FString Contents;
+            if (SkipUnchanged || !IsFromFile)
+            {
+                if (!ReadSectionContents(Section, Archive, Contents))
+                {
+                    return ESettingsSectionStatus::Failed;
+                }
+                OutNumBytes = GetSavedSize(Contents);
+
+                // none of its keys matched the key filter
+                if (Section.KeyFilter.IsValid() && Contents.IsEmpty())
+                {
+                    return ESettingsSectionStatus::Unchanged;
+                }
+
+                // only the merged keys are loaded, which leaves the rest of the object as it is
+                if (FString MergedContents;
+                    IsMerge && MergeSection(Section, Contents, DefaultConfigs, MergedContents, Stats.NumConflicts))
+                {
+                    if (MergedContents.IsEmpty())
+                    {
+                        return ESettingsSectionStatus::Unchanged;
+                    }
+                    Contents = MoveTemp(MergedContents);
+                }
+                // loading a section reloads its object and saving it rewrites its config file, so both are skipped when nothing would change
+                else if (TArray<FSettingsKeyDiff> Diffs;
+                    SkipUnchanged && DiffSection(Section, Contents, Diffs) && Diffs.IsEmpty())
+                {
+                    return ESettingsSectionStatus::Unchanged;
+                }
+            }
+
+            // taken right before the section changes, so that the snapshot only holds what the import affects
+            if (Snapshot.IsSet() && !Snapshot->AddSection(Section))
+            {
+                UE_LOG(LogSettingsManager, Warning, TEXT("Couldn't snapshot %s before importing it"), *Section.Key.ToString());
+            }
+
+            if (IsFromFile)
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(ISettingsSection::Import);
+                if (Contents.IsEmpty())
+                {
+                    OutNumBytes = IFileManager::Get().FileSize(*Section.FilePath);
+                }
+                return Section.Section->Import(Section.FilePath) ? ESettingsSectionStatus::Succeeded : ESettingsSectionStatus::Failed;
+            }
+
+            const FString VirtualFileName = Archive != nullptr ? FPaths::Combine(Archive->GetFilePath(), Section.Key.ToString() + TEXT(".ini")) : Section.FilePath;
+            return ImportSectionContents(Section.Section, Contents, VirtualFileName) ? ESettingsSectionStatus::Succeeded : ESettingsSectionStatus::Failed;
+        };
+
+    const bool IsBatched = CVarBatchedImport.GetValueOnGameThread();
+
+    // read everything in first, since GConfig can't load the source files while its file operations are disabled
+    TArray<int32> DeferredSaves;
+    for (int32 Index = 0; Index < Sections.Num(); ++Index)
+    {
+        const FSettingsSectionFile& Section = Sections[Index];
+        FSettingsSectionResult& Result = Stats.SectionResults[Index];
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Section.Key.ToString());
+        const double SectionStartTime = FPlatformTime::Seconds();
+
+        Result.Status = Import(Section, Result.NumBytes);
+        if (Result.Status == ESettingsSectionStatus::Succeeded)
+        {
+            if (IsBatched && CanDeferSave(Section.Section))
+            {
+                DeferredSaves.Add(Index);
+            }
+            // default and user config files are written directly rather than through GConfig, so there's nothing to batch
+            else
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(ISettingsSection::Save);
+                if (Section.Section->Save())
+                {
+                    ++Stats.NumFilesWritten;
+                }
+                else
+                {
+                    Result.Status = ESettingsSectionStatus::Failed;
+                }
+            }
+        }
+
+        Result.ElapsedSeconds = FPlatformTime::Seconds() - SectionStartTime;
+    }
+
+    // written before the sections are saved, so that a failure from there on can already be rolled back
+    if (Snapshot.IsSet())
+    {
+        Stats.SnapshotName = Snapshot->Save();
+    }
+
+    if (DeferredSaves.Num() > 0)
+    {
+        TSet<FString> DirtyConfigFiles;
+        GConfig->DisableFileOperations();
+        for (const int32 Index : DeferredSaves)
+        {
+            const FSettingsSectionFile& Section = Sections[Index];
+            FSettingsSectionResult& Result = Stats.SectionResults[Index];
+            TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Section.Key.ToString());
+            const double SectionStartTime = FPlatformTime::Seconds();
+
+            bool Saved;
+            {
+                TRACE_CPUPROFILER_EVENT_SCOPE(ISettingsSection::Save);
+                Saved = Section.Section->Save();
+            }
+
+            if (Saved)
+            {
+                DirtyConfigFiles.Add(Section.Section->GetSettingsObject()->GetClass()->GetConfigName());
+            }
+            else
+            {
+                Result.Status = ESettingsSectionStatus::Failed;
+            }
+
+            Result.ElapsedSeconds += FPlatformTime::Seconds() - SectionStartTime;
+        }
+        GConfig->EnableFileOperations();
+
+        // shared by the sections, so this isn't part of their own times
+        TRACE_CPUPROFILER_EVENT_SCOPE(FlushDirtyConfigFiles);
+        for (const FString& ConfigFile : DirtyConfigFiles)
+        {
+            GConfig->Flush(false, ConfigFile);
+        }
+        Stats.NumFilesWritten += DirtyConfigFiles.Num();
+    }
+
+    for (int32 Index = 0; Index < Sections.Num(); ++Index)
+    {
+        switch (Stats.SectionResults[Index].Status)
+        {
+        case ESettingsSectionStatus::Succeeded:
+            ++Stats.NumSectionsImported;
+            break;
+        case ESettingsSectionStatus::Unchanged:
+            ++Stats.NumSectionsUnchanged;
+            break;
+        case ESettingsSectionStatus::Failed:
+            OutFailures.Add(Sections[Index].DisplayName);
+            break;
+        }
+    }
+
+    Stats.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    return Stats;
+}
+
+void FSettingsManagerOperations::ReportResults(const TCHAR* Operation, const TArray<FSettingsSectionResult>& Results, int64 NumBytes,
+    double ElapsedSeconds)
+{
+    const FSettingsSectionResult* SlowestResult = nullptr;
+    for (const FSettingsSectionResult& Result : Results)
+    {
+        if (SlowestResult == nullptr || Result.ElapsedSeconds > SlowestResult->ElapsedSeconds)
+        {
+            SlowestResult = &Result;
+        }
+    }
+
+    UE_LOG(LogSettingsManager, Log, TEXT("%s of %d sections: %lld bytes in %.1f ms (%.2f ms per section), slowest %s at %.1f ms"),
+        Operation, Results.Num(), NumBytes, ElapsedSeconds * 1000.0, Results.Num() > 0 ? ElapsedSeconds * 1000.0 / Results.Num() : 0.0,
+        SlowestResult != nullptr ? *SlowestResult->Key.ToString() : TEXT("-"), SlowestResult != nullptr ? SlowestResult->ElapsedSeconds * 1000.0 : 0.0);
+
+    const FString ReportFolder = CVarReportFolder.GetValueOnGameThread();
+    if (ReportFolder.IsEmpty())
+    {
+        return;
+    }
+
+    static const TCHAR* const StatusNames[] = { TEXT("Succeeded"), TEXT("Unchanged"), TEXT("Failed") };
+
+    TStringBuilder<8192> Report;
+    Report << TEXT("Container,Category,Section,Status,Milliseconds,Bytes\n");
+    for (const FSettingsSectionResult& Result : Results)
+    {
+        Report.Appendf(TEXT("%s,%s,%s,%s,%.3f,%lld\n"), *Result.Key.ContainerName.ToString(), *Result.Key.CategoryName.ToString(),
+            *Result.Key.SectionName.ToString(), StatusNames[static_cast<uint8>(Result.Status)], Result.ElapsedSeconds * 1000.0, Result.NumBytes);
+    }
+
+    const FString ReportPath = FPaths::Combine(ReportFolder,
+        FString::Printf(TEXT("SettingsManager-%s-%s.csv"), Operation, *FDateTime::Now().ToString()));
+    if (!FFileHelper::SaveStringToFile(Report.ToView(), *ReportPath))
+    {
+        UE_LOG(LogSettingsManager, Warning, TEXT("Couldn't write the report '%s'"), *ReportPath);
+    }
+}
+
+const TCHAR* const FSettingsExportTask::ManifestFileName = TEXT("SettingsManifest.txt");
+
+FSettingsExportTask::FSettingsExportTask(TArray<FCapturedSettingsSection>&& InSections, FString InArchivePath)
+    : Sections(MoveTemp(InSections))
+    , ArchivePath(MoveTemp(InArchivePath))
+{
+}
+
+void FSettingsExportTask::Start(FOnFinished InOnFinished)
+{
+    Async(EAsyncExecution::ThreadPool, [This = AsShared(), OnFinished = MoveTemp(InOnFinished)]()
+        {
+            This->Run();
+
+            AsyncTask(ENamedThreads::GameThread, [This, OnFinished]()
+                {
+                    OnFinished.ExecuteIfBound(*This);
+                });
+        });
+}
+
+void FSettingsExportTask::Run()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsExportTask::Run);
+
+    // the sections that aren't reached before a cancellation stay failed
+    SectionResults.Reset(Sections.Num());
+    for (const FCapturedSettingsSection& Section : Sections)
+    {
+        SectionResults.Add({ Section.Key, ESettingsSectionStatus::Failed, Section.CaptureSeconds });
+    }
+
+    if (!ArchivePath.IsEmpty())
+    {
+        if (!IsCancelRequested)
+        {
+            // the archive is written at once, so that time isn't part of the sections' own times
+            const bool Written = FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(ArchivePath)) &&
+                FSettingsArchive::Write(ArchivePath, Sections, CVarCompressArchives.GetValueOnAnyThread());
+            if (Written)
+            {
+                NumBytesWritten = IFileManager::Get().FileSize(*ArchivePath);
+            }
+            else
+            {
+                Failures.Add(FText::FromString(ArchivePath));
+            }
+            for (FSettingsSectionResult& Result : SectionResults)
+            {
+                Result.Status = Written ? ESettingsSectionStatus::Succeeded : ESettingsSectionStatus::Failed;
+            }
+            NumProcessed = Sections.Num();
+        }
+        return;
+    }
+
+    if (!ManifestFolder.IsEmpty())
+    {
+        RunIncremental();
+        return;
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    FString LastFolder;
+    bool IsLastFolderCreated = false;
+    for (int32 Index = 0; Index < Sections.Num(); ++Index)
+    {
+        if (IsCancelRequested)
+        {
+            break;
+        }
+
+        const FCapturedSettingsSection& Section = Sections[Index];
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Section.Key.ToString());
+        const double StartTime = FPlatformTime::Seconds();
+
+        // sections are grouped by category, so this only hits the file system once per folder
+        if (const FString Folder = FPaths::GetPath(Section.FilePath);
+            Folder != LastFolder)
+        {
+            LastFolder = Folder;
+            IsLastFolderCreated = PlatformFile.CreateDirectoryTree(*Folder);
+        }
+
+        if (IsLastFolderCreated && FFileHelper::SaveStringToFile(Section.Contents, *Section.FilePath))
+        {
+            SectionResults[Index].Status = ESettingsSectionStatus::Succeeded;
+            SectionResults[Index].NumBytes = GetSavedSize(Section.Contents);
+            NumBytesWritten += SectionResults[Index].NumBytes;
+        }
+        else
+        {
+            Failures.Add(Section.DisplayName);
+        }
+        SectionResults[Index].ElapsedSeconds += FPlatformTime::Seconds() - StartTime;
+
+        ++NumProcessed;
+    }
+}
+
+void FSettingsExportTask::RunIncremental()
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString ManifestPath = FPaths::Combine(ManifestFolder, ManifestFileName);
+
+    // one "<SHA-1> <path relative to the export folder>" line per file
+    TMap<FString, FString> Manifest;
+    {
+        TArray<FString> Lines;
+        FFileHelper::LoadFileToStringArray(Lines, *ManifestPath);
+        for (const FString& Line : Lines)
+        {
+            FString Hash;
+            FString RelativePath;
+            if (Line.Split(TEXT(" "), &Hash, &RelativePath))
+            {
+                Manifest.Add(MoveTemp(RelativePath), MoveTemp(Hash));
+            }
+        }
+    }
+
+    bool IsManifestDirty = false;
+    FString LastFolder;
+    bool IsLastFolderCreated = false;
+    for (int32 Index = 0; Index < Sections.Num(); ++Index)
+    {
+        if (IsCancelRequested)
+        {
+            break;
+        }
+
+        const FCapturedSettingsSection& Section = Sections[Index];
+        FSettingsSectionResult& Result = SectionResults[Index];
+        TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Section.Key.ToString());
+        const double StartTime = FPlatformTime::Seconds();
+
+        const FTCHARToUTF8 Utf8Contents(*Section.Contents);
+        FSHAHash ContentHash;
+        FSHA1::HashBuffer(Utf8Contents.Get(), Utf8Contents.Length(), ContentHash.Hash);
+        const FString Hash = ContentHash.ToString();
+
+        FString RelativePath = Section.FilePath;
+        FPaths::MakePathRelativeTo(RelativePath, *(ManifestFolder / TEXT("")));
+
+        // the file is checked too so that deleting an exported file and exporting again brings it back
+        if (const FString* PreviousHash = Manifest.Find(RelativePath);
+            PreviousHash != nullptr && *PreviousHash == Hash && PlatformFile.FileExists(*Section.FilePath))
+        {
+            Result.Status = ESettingsSectionStatus::Unchanged;
+            Result.ElapsedSeconds += FPlatformTime::Seconds() - StartTime;
+            ++NumUnchanged;
+            ++NumProcessed;
+            continue;
+        }
+
+        if (const FString Folder = FPaths::GetPath(Section.FilePath);
+            Folder != LastFolder)
+        {
+            LastFolder = Folder;
+            IsLastFolderCreated = PlatformFile.CreateDirectoryTree(*Folder);
+        }
+
+        if (IsLastFolderCreated && FFileHelper::SaveStringToFile(Section.Contents, *Section.FilePath))
+        {
+            Manifest.Add(MoveTemp(RelativePath), Hash);
+            Result.Status = ESettingsSectionStatus::Succeeded;
+            Result.NumBytes = GetSavedSize(Section.Contents);
+            NumBytesWritten += Result.NumBytes;
+        }
+        else
+        {
+            Manifest.Remove(RelativePath);
+            Failures.Add(Section.DisplayName);
+        }
+        IsManifestDirty = true;
+        Result.ElapsedSeconds += FPlatformTime::Seconds() - StartTime;
+
+        ++NumProcessed;
+    }
+
+    if (!IsManifestDirty)
+    {
+        return;
+    }
+
+    // entries of sections that weren't part of this export are kept, since their files are still there
+    Manifest.KeySort(TLess<FString>());
+
+    TStringBuilder<4096> ManifestContents;
+    for (const auto& [RelativePath, Hash] : Manifest)
+    {
+        ManifestContents << Hash << TEXT(' ') << RelativePath << TEXT('\n');
+    }
+
+    if (PlatformFile.CreateDirectoryTree(*ManifestFolder) && FFileHelper::SaveStringToFile(ManifestContents.ToView(), *ManifestPath))
+    {
+        NumBytesWritten += ManifestContents.Len();
+    }
+    else
+    {
+        Failures.Add(FText::FromString(ManifestPath));
+    }
+}
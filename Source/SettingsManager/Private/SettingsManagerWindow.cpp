@@ -7,22 +7,57 @@
 #include "ISettingsContainer.h"
 #include "ISettingsModule.h"
 #include "ISettingsSection.h"
+#include "SettingsArchive.h"
+#include "SettingsManagerOperations.h"
+#include "SettingsPresets.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Input/SComboButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SExpanderArrow.h"
 
 #define LOCTEXT_NAMESPACE "FSettingsManagerModule"
 
-void SSettingsManagerWindow::Construct([[maybe_unused]] const FArguments& InArgs, bool IsForExport, FImportData ImportDataParam)
+namespace
 {
-    ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
-    check(SettingsModule != nullptr);
-    SettingsContainers.Add(SettingsModule->GetContainer("Editor"));
-    check(SettingsContainers[0].IsValid());
+    const FName EditorContainerName("Editor");
+    const FName ProjectContainerName("Project");
 
-    SettingsContainers.Add(SettingsModule->GetContainer("Project"));
-    check(SettingsContainers[1].IsValid());
+    /** Lowercased once when a row is listed, so that searching never has to go through FText. */
+    FString MakeSearchableText(const FText& DisplayName, FName Name)
+    {
+        return (DisplayName.ToString() + TEXT('\n') + Name.ToString()).ToLower();
+    }
+}
+
+SSettingsManagerWindow::~SSettingsManagerWindow()
+{
+    for (const TSharedPtr<ISettingsContainer>& SettingsContainer : SettingsContainers)
+    {
+        SettingsContainer->OnCategoryModified().RemoveAll(this);
+    }
+}
 
-    SettingsDataToExport.AddDefaulted(2);
-    SettingsDataToImport.AddDefaulted(2);
+void SSettingsManagerWindow::Construct([[maybe_unused]] const FArguments& InArgs, bool IsForExport, TSharedPtr<const FSettingsImportData> InImportManifest)
+{
+    // every container gets a tab, including the ones registered by other tools, but a tab is only built once it's shown
+    SettingsContainers = FSettingsManagerOperations::GetContainers();
+    check(!SettingsContainers.IsEmpty());
+
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        SettingsContainers[TabIndex]->OnCategoryModified().AddSP(this, &SSettingsManagerWindow::HandleCategoryModified, TabIndex);
+    }
+
+    const int32 NumTabs = SettingsContainers.Num();
+    SectionTables.AddDefaulted(NumTabs);
+    TabSelectionCounts.AddDefaulted(NumTabs);
+    TreeRootItems.AddDefaulted(NumTabs);
+    VisibleRootItems.AddDefaulted(NumTabs);
+    TabSearches.AddDefaulted(NumTabs);
+    TreeViews.AddDefaulted(NumTabs);
+    TabWidgets.AddDefaulted(NumTabs);
 
     if (IsForExport)
     {
@@ -30,7 +65,8 @@ void SSettingsManagerWindow::Construct([[maybe_unused]] const FArguments& InArgs
     }
     else
     {
-        ImportData = MoveTemp(ImportDataParam);
+        check(InImportManifest.IsValid());
+        ImportManifest = MoveTemp(InImportManifest);
         OnSpawnTab<false>();
     }
 }
@@ -38,8 +74,20 @@ void SSettingsManagerWindow::Construct([[maybe_unused]] const FArguments& InArgs
 template <bool IsForExport>
 void SSettingsManagerWindow::OnSpawnTab()
 {
-    const TSharedRef<SVerticalBox> EditorPreferencesTab = CreateTab<IsForExport>(0);
-    const TSharedRef<SVerticalBox> ProjectSettingsTab = CreateTab<IsForExport>(1);
+    const TSharedRef<SVerticalBox> TabButtons = SNew(SVerticalBox);
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        TabButtons->AddSlot()
+            .AutoHeight()
+            .Padding(3)
+            [
+                SNew(SButton)
+                    .HAlign(EHorizontalAlignment::HAlign_Center)
+                    .Text(GetTabTitle(TabIndex))
+                    .OnClicked_Lambda([this, TabIndex]() { SelectTab<IsForExport>(TabIndex); return FReply::Handled(); })
+            ];
+    }
+
     ChildSlot
         [
             SNew(SHorizontalBox)
@@ -47,25 +95,7 @@ void SSettingsManagerWindow::OnSpawnTab()
                 .AutoWidth()
                 .Padding(FMargin{ 30, 10, 10, 10 })
                 [
-                    SNew(SVerticalBox)
-                        + SVerticalBox::Slot()
-                        .AutoHeight()
-                        .Padding(3)
-                        [
-                            SNew(SButton)
-                                .HAlign(EHorizontalAlignment::HAlign_Center)
-                                .Text(LOCTEXT("EditorPreferencesTabTitle", "Editor Preferences"))
-                                .OnClicked_Lambda([this]() { CurrentTabIndex = 0; return FReply::Handled(); })
-                        ]
-                        + SVerticalBox::Slot()
-                        .AutoHeight()
-                        .Padding(3)
-                        [
-                            SNew(SButton)
-                                .HAlign(EHorizontalAlignment::HAlign_Center)
-                                .Text(LOCTEXT("ProjectSettingsTabTitle", "Project Settings"))
-                                .OnClicked_Lambda([this]() { CurrentTabIndex = 1; return FReply::Handled(); })
-                        ]
+                    TabButtons
                 ]
                 + SHorizontalBox::Slot()
                 .AutoWidth()
@@ -77,202 +107,147 @@ void SSettingsManagerWindow::OnSpawnTab()
                 + SHorizontalBox::Slot()
                 .FillWidth(1.f)
                 [
-                    EditorPreferencesTab
-                ]
-                + SHorizontalBox::Slot()
-                .FillWidth(1.f)
-                [
-                    ProjectSettingsTab
+                    SAssignNew(TabContent, SBox)
                 ]
         ];
+
+    SelectTab<IsForExport>(CurrentTabIndex);
 }
 
 template<bool IsForExport>
-TSharedRef<SVerticalBox> SSettingsManagerWindow::CreateTab(int TabIndex)
+void SSettingsManagerWindow::SelectTab(int TabIndex)
 {
-    // sort the sections alphabetically
-    struct FSectionSortPredicate
+    // a tab is only built the first time it's shown, and then kept around for when it's shown again
+    if (!TabWidgets[TabIndex].IsValid())
     {
-        FORCEINLINE bool operator()(ISettingsSectionPtr A, ISettingsSectionPtr B) const
-        {
-            if (!A.IsValid() && !B.IsValid())
-            {
-                return false;
-            }
+        TabWidgets[TabIndex] = CreateTab<IsForExport>(TabIndex);
+    }
 
-            if (A.IsValid() != B.IsValid())
-            {
-                return B.IsValid();
-            }
+    CurrentTabIndex = TabIndex;
+    TabContent->SetContent(TabWidgets[TabIndex].ToSharedRef());
+}
 
-            return (A->GetDisplayName().CompareTo(B->GetDisplayName()) < 0);
-        }
-    };
-    
+template<bool IsForExport>
+TSharedRef<SVerticalBox> SSettingsManagerWindow::CreateTab(int TabIndex)
+{
+    TArray<FSettingsCategorySections> CategoriesSections;
     if constexpr (IsForExport)
     {
-        TArray<TSharedPtr<ISettingsCategory>> SettingsCategories;
-        SettingsContainers[TabIndex]->GetCategories(SettingsCategories);
-        for (const TSharedPtr<ISettingsCategory>& Category : SettingsCategories)
-        {
-            auto& [DisplayName, Sections] = SettingsDataToExport[TabIndex].Add(Category->GetName());
-            DisplayName = Category->GetDisplayName();
+        CategoriesSections = FSettingsManagerOperations::GetExportableSections(SettingsContainers[TabIndex]);
+    }
+    else
+    {
+        CategoriesSections = FSettingsManagerOperations::GetImportableSections(SettingsContainers[TabIndex], *ImportManifest);
+    }
 
-            TArray<TSharedPtr<ISettingsSection>> SettingsSections;
-            Category->GetSections(SettingsSections);
-            SettingsSections.Sort(FSectionSortPredicate{});
+    int32 NumSections = 0;
+    for (const FSettingsCategorySections& CategorySections : CategoriesSections)
+    {
+        NumSections += CategorySections.Sections.Num();
+    }
 
-            for (const TSharedPtr<ISettingsSection>& Section : SettingsSections)
-            {
-                if (Section->CanExport())
-                {
-                    Sections.Add(Section->GetName(), { Section->GetDisplayName(), ECheckBoxState::Unchecked });
-                }
-            }
-        }
+    FSectionTable& Table = SectionTables[TabIndex];
+    Table = {};
+    Table.Categories.Reserve(CategoriesSections.Num());
+    Table.SectionNames.Reserve(NumSections);
+    Table.SectionDisplayNames.Reserve(NumSections);
+    Table.SectionCategories.Reserve(NumSections);
+    if constexpr (!IsForExport)
+    {
+        Table.SectionFilePaths.Reserve(NumSections);
+        Table.SectionDifferences.SetNum(NumSections);
     }
-    else
+    // everything is imported unless deselected, but nothing is exported unless selected
+    Table.CheckedSections.Init(!IsForExport, NumSections);
+    Table.ReverseLevelSections.Init(false, NumSections);
+
+    const FName ContainerName = SettingsContainers[TabIndex]->GetName();
+    for (const FSettingsCategorySections& CategorySections : CategoriesSections)
     {
-        for (const auto& [CategoryName, Sections] : ImportData)
+        const FName CategoryName = CategorySections.Category->GetName();
+        const int32 CategoryIndex = Table.Categories.Add({ CategoryName, CategorySections.Category->GetDisplayName(), Table.Num(), CategorySections.Sections.Num() });
+
+        for (int SectionIndex = 0; SectionIndex < CategorySections.Sections.Num(); ++SectionIndex)
         {
-            const TSharedPtr<ISettingsCategory>& Category = SettingsContainers[TabIndex]->GetCategory(CategoryName);
-            if (!Category.IsValid())
+            const TSharedPtr<ISettingsSection>& Section = CategorySections.Sections[SectionIndex];
+            const int32 Index = Table.SectionNames.Add(Section->GetName());
+            Table.SectionDisplayNames.Add(Section->GetDisplayName());
+            Table.SectionCategories.Add(CategoryIndex);
+            if constexpr (!IsForExport)
             {
-                continue;
+                Table.SectionFilePaths.Add(CategorySections.FilePaths[SectionIndex]);
             }
 
-            auto& [DisplayName, SectionsData] = SettingsDataToImport[TabIndex].Add(CategoryName);
-            DisplayName = Category->GetDisplayName();
+            if (IsSavedAtReverseLevel(ContainerName, IsSectionSavedProjectBased(Section)))
+            {
+                Table.ReverseLevelSections[Index] = true;
+                ++Table.Categories[CategoryIndex].NumAtReverseLevel;
+            }
 
-            for (const auto& [SectionName, FilePath] : Sections)
+            if (AppliedPreset.IsSet())
             {
-                const TSharedPtr<ISettingsSection> Section = Category->GetSection(SectionName);
-                if (Section.IsValid() && Section->CanImport())
-                {
-                    SectionsData.Add(SectionName, { Section->GetDisplayName(), ECheckBoxState::Checked, FilePath });
-                }
+                Table.CheckedSections[Index] = AppliedPreset->Contains({ ContainerName, CategoryName, Section->GetName() });
             }
         }
     }
+    Table.FindFalsePositiveSections(SettingsContainers[TabIndex]);
 
-    const TSharedRef<SVerticalBox> VerticalBox = SNew(SVerticalBox).Visibility(this, &SSettingsManagerWindow::GetTabVisibility, TabIndex);
-
-    TMap<FName, std::conditional_t<IsForExport, FCategoryDataForExport, FCategoryDataForImport>>& SettingsDataToUse =
-        [this, TabIndex]() -> auto&
-        {
-            if constexpr (IsForExport)
-            {
-                return SettingsDataToExport[TabIndex];
-            }
-            else
-            {
-                return SettingsDataToImport[TabIndex];
-            }
-        }();
+    const TSharedRef<SVerticalBox> VerticalBox = SNew(SVerticalBox);
 
-    const auto LambdaIsSavedProjectBased = [SettingsContainer = SettingsContainers[TabIndex]](const FName CategoryName, const FName SectionName)
-        {
-            const TWeakObjectPtr<UObject> SettingsObject = SettingsContainer->GetCategory(CategoryName)->GetSection(SectionName)->GetSettingsObject();
-            return SettingsObject.IsValid() && SettingsObject->GetClass()->HasAnyClassFlags(CLASS_DefaultConfig);
-        };
+    FSelectionCounts& TabCounts = TabSelectionCounts[TabIndex];
+    TabCounts = {};
+    for (int32 CategoryIndex = 0; CategoryIndex < Table.Categories.Num(); ++CategoryIndex)
+    {
+        const FSelectionCounts& CategoryCounts = Table.Categories[CategoryIndex].SelectionCounts = Table.CountSelection(CategoryIndex);
+        TabCounts.NumTotal += CategoryCounts.NumTotal;
+        TabCounts.NumChecked += CategoryCounts.NumChecked;
+        TabCounts.NumCheckedAtReverseLevel += CategoryCounts.NumCheckedAtReverseLevel;
+    }
 
     const auto LambdaSelectAllOnCheckStateChanged = 
-        [&SettingsDataToUse](ECheckBoxState State)
+        [this, &Table, TabIndex](ECheckBoxState State)
         {
-            for (auto& [CategoryName, CategoryData] : SettingsDataToUse)
+            for (int32 CategoryIndex = 0; CategoryIndex < Table.Categories.Num(); ++CategoryIndex)
             {
-                for (auto& [_, SectionData] : CategoryData.Sections)
-                {
-                    SectionData.CheckBoxState = State;
-                }
+                SetCategoryCheckBoxState(TabIndex, CategoryIndex, State);
             }
         };
 
     const auto LambdaSelectAllIsChecked =
-        [&SettingsDataToUse]()
+        [&TabCounts]()
         {
-            bool Initialized = false;
-            ECheckBoxState State = ECheckBoxState::Unchecked;
-            for (const auto& [CategoryName, CategoryData] : SettingsDataToUse)
-            {
-                for (const auto& [_, SectionData] : CategoryData.Sections)
-                {
-                    if (!Initialized)
-                    {
-                        State = SectionData.CheckBoxState;
-                        Initialized = true;
-                    }
-                    else if (State != SectionData.CheckBoxState)
-                    {
-                        return ECheckBoxState::Undetermined;
-                    }
-                }
-            }
-            return State;
+            return TabCounts.GetCheckBoxState();
         };
 
     const auto LambdaReverseSavedSettingsWarningVisibility =
-        [&SettingsDataToUse, LambdaIsSavedProjectBased, TabIndex]()
+        [&TabCounts]()
         {
-            for (const auto& [CategoryName, CategoryData] : SettingsDataToUse)
-            {
-                for (const auto& [SectionName, SectionData] : CategoryData.Sections)
-                {
-                    if (SectionData.CheckBoxState != ECheckBoxState::Checked)
-                    {
-                        continue;
-                    }
-
-                    if (const bool IsProjectBased = LambdaIsSavedProjectBased(CategoryName, SectionName);
-                        (TabIndex == 0 && IsProjectBased) || (TabIndex == 1 && !IsProjectBased))
-                    {
-                        return EVisibility::Visible;
-                    }
-                }
-            }
-
-            return EVisibility::Collapsed;
+            return TabCounts.NumCheckedAtReverseLevel > 0 ? EVisibility::Visible : EVisibility::Collapsed;
         };
 
     const auto LambdaDeselectAllReverseSavedSettings =
-        [&SettingsDataToUse, LambdaIsSavedProjectBased, TabIndex]()
+        [this, &Table, TabIndex]()
         {
-            for (auto& [CategoryName, CategoryData] : SettingsDataToUse)
+            const TBitArray<> CheckedAtReverseLevel = TBitArray<>::BitwiseAND(Table.CheckedSections, Table.ReverseLevelSections, EBitwiseOperatorFlags::MinSize);
+            for (TConstSetBitIterator<> It(CheckedAtReverseLevel); It; ++It)
             {
-                for (auto& [SectionName, SectionData] : CategoryData.Sections)
-                {
-                    if (SectionData.CheckBoxState == ECheckBoxState::Checked)
-                    {
-                        if (const bool IsProjectBased = LambdaIsSavedProjectBased(CategoryName, SectionName);
-                            (TabIndex == 0 && IsProjectBased) || (TabIndex == 1 && !IsProjectBased))
-                        {
-                            SectionData.CheckBoxState = ECheckBoxState::Unchecked;
-                        }
-                    }
-                }
+                SetSectionCheckBoxState(TabIndex, It.GetIndex(), ECheckBoxState::Unchecked);
             }
             return FReply::Handled();
         };
 
     const auto LambdaFalsePositiveNoteVisibility = 
-        [&SettingsDataToUse, TabIndex]()
+        [&Table, ContainerName]()
         {
-            if (!IsForExport)
+            if (!IsForExport || ContainerName != EditorContainerName)
             {
                 return EVisibility::Collapsed;
             }
 
-            if (TabIndex == 0 && SettingsDataToUse.Contains("General"))
+            if ((Table.AppearanceSection != INDEX_NONE && Table.CheckedSections[Table.AppearanceSection]) ||
+                (Table.InputBindingsSection != INDEX_NONE && Table.CheckedSections[Table.InputBindingsSection]))
             {
-                const auto& GeneralCategory = SettingsDataToUse["General"];
-                if (GeneralCategory.Sections.Contains("Appearance") && GeneralCategory.Sections["Appearance"].CheckBoxState == ECheckBoxState::Checked)
-                {
-                    return EVisibility::Visible;
-                }
-                if (GeneralCategory.Sections.Contains("InputBindings") && GeneralCategory.Sections["InputBindings"].CheckBoxState == ECheckBoxState::Checked)
-                {
-                    return EVisibility::Visible;
-                }
+                return EVisibility::Visible;
             }
 
             return EVisibility::Collapsed;
@@ -287,16 +262,35 @@ TSharedRef<SVerticalBox> SSettingsManagerWindow::CreateTab(int TabIndex)
                 + SHorizontalBox::Slot()
                 .HAlign(EHorizontalAlignment::HAlign_Left)
                 [
-                    SNew(SCheckBox)
-                        .Padding(FMargin{ 10, 0, 0, 0 })
-                        .Content()
+                    SNew(SHorizontalBox)
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .VAlign(EVerticalAlignment::VAlign_Center)
                         [
-                            SNew(STextBlock)
-                                .Text(LOCTEXT("SelectDeselectAll", "Select / Deselect All"))
-                                .ColorAndOpacity(FLinearColor::Green)
+                            SNew(SCheckBox)
+                                .Padding(FMargin{ 10, 0, 0, 0 })
+                                .Content()
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("SelectDeselectAll", "Select / Deselect All"))
+                                        .ColorAndOpacity(FLinearColor::Green)
+                                ]
+                                .OnCheckStateChanged_Lambda(LambdaSelectAllOnCheckStateChanged)
+                                .IsChecked_Lambda(LambdaSelectAllIsChecked)
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .VAlign(EVerticalAlignment::VAlign_Center)
+                        .Padding(20, 0, 0, 0)
+                        [
+                            SNew(SComboButton)
+                                .ButtonContent()
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("PresetsButton", "Presets"))
+                                ]
+                                .OnGetMenuContent(this, &SSettingsManagerWindow::MakePresetsMenu)
                         ]
-                        .OnCheckStateChanged_Lambda(LambdaSelectAllOnCheckStateChanged)
-                        .IsChecked_Lambda(LambdaSelectAllIsChecked)
                 ]
                 + SHorizontalBox::Slot()
                 .HAlign(EHorizontalAlignment::HAlign_Center)
@@ -308,9 +302,9 @@ TSharedRef<SVerticalBox> SSettingsManagerWindow::CreateTab(int TabIndex)
                         [
                             SNew(STextBlock)
                                 .Justification(ETextJustify::Center)
-                                .Text(TabIndex == 0 ? 
+                                .Text(ContainerName == EditorContainerName ? 
                                     LOCTEXT("ProjectSavedSettingsExistWarning", "WARNING: Some of the selected settings are saved at project-level.") :
-                                    TabIndex == 1 ?
+                                    ContainerName == ProjectContainerName ?
                                     LOCTEXT("EditorSavedSettingsExistWarning", "WARNING: Some of the selected settings are saved at editor-level.") :
                                     FText::GetEmpty()
                                 )
@@ -341,272 +335,1165 @@ TSharedRef<SVerticalBox> SSettingsManagerWindow::CreateTab(int TabIndex)
                 + SHorizontalBox::Slot()
                 .HAlign(EHorizontalAlignment::HAlign_Right)
                 [
-                    SNew(SButton)
+                    SNew(SHorizontalBox)
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .VAlign(EVerticalAlignment::VAlign_Center)
+                        .Padding(0, 0, 10, 0)
+                        [
+                            SNew(SCheckBox)
+                                .ToolTipText(IsForExport ?
+                                    LOCTEXT("AllContainersExportTooltip", "Export the selected sections of every tab at once, each tab in its own subfolder of the chosen folder.") :
+                                    LOCTEXT("AllContainersImportTooltip", "Import the selected sections of every tab at once.\n"
+                                        "Only available for archives and for folders exported from every tab, since the sections of a folder exported from a single tab could match the ones of other tabs."))
+                                .IsEnabled_Lambda([this]() { return CanProcessAllContainers(); })
+                                .IsChecked_Lambda([this]() { return AllContainers ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                                .OnCheckStateChanged_Lambda([this](ECheckBoxState State) { AllContainers = State == ECheckBoxState::Checked; })
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("AllContainers", "All Tabs"))
+                                ]
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .VAlign(EVerticalAlignment::VAlign_Center)
+                        .Padding(0, 0, 10, 0)
+                        [
+                            SNew(SCheckBox)
+                                .Visibility(IsForExport ? EVisibility::Visible : EVisibility::Collapsed)
+                                .ToolTipText(LOCTEXT("ExportAsArchiveTooltip", "Pack every selected section into one indexed archive file instead of a folder of .ini files."))
+                                .IsChecked_Lambda([this]() { return ExportAsArchive ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                                .OnCheckStateChanged_Lambda([this](ECheckBoxState State) { ExportAsArchive = State == ECheckBoxState::Checked; })
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("ExportAsArchive", "Single Archive"))
+                                ]
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .VAlign(EVerticalAlignment::VAlign_Center)
+                        .Padding(0, 0, 10, 0)
+                        [
+                            SNew(SCheckBox)
+                                .Visibility(IsForExport ? EVisibility::Visible : EVisibility::Collapsed)
+                                .IsEnabled_Lambda([this]() { return !ExportAsArchive; })
+                                .ToolTipText(LOCTEXT("IncrementalExportTooltip", "Only rewrite the files whose contents changed since the last export to the same folder."))
+                                .IsChecked_Lambda([this]() { return IncrementalExport ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                                .OnCheckStateChanged_Lambda([this](ECheckBoxState State) { IncrementalExport = State == ECheckBoxState::Checked; })
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("IncrementalExport", "Incremental"))
+                                ]
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
                         .VAlign(EVerticalAlignment::VAlign_Center)
-                        .Text(IsForExport ? LOCTEXT("ExportButton", "Export") : LOCTEXT("ImportButton", "Import"))
-                        .OnClicked_Raw(this, IsForExport ? &SSettingsManagerWindow::DoExport : &SSettingsManagerWindow::DoImport)
+                        .Padding(0, 0, 10, 0)
+                        [
+                            SNew(SCheckBox)
+                                .Visibility(IsForExport ? EVisibility::Collapsed : EVisibility::Visible)
+                                .ToolTipText(LOCTEXT("MergeImportTooltip", "Only import the keys the files change from their defaults, and keep the local changes to the others."))
+                                .IsChecked_Lambda([this]() { return MergeImport ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                                .OnCheckStateChanged_Lambda([this](ECheckBoxState State) { MergeImport = State == ECheckBoxState::Checked; })
+                                [
+                                    SNew(STextBlock)
+                                        .Text(LOCTEXT("MergeImport", "Merge"))
+                                ]
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        .Padding(0, 0, 10, 0)
+                        [
+                            SNew(SButton)
+                                .Visibility(IsForExport ? EVisibility::Collapsed : EVisibility::Visible)
+                                .VAlign(EVerticalAlignment::VAlign_Center)
+                                .Text(LOCTEXT("ShowDifferencesButton", "Show Differences"))
+                                .ToolTipText(LOCTEXT("ShowDifferencesButtonTooltip", "Compare every section with the current settings, and only list the ones that would change."))
+                                .OnClicked_Raw(this, &SSettingsManagerWindow::ShowDifferences)
+                        ]
+                        + SHorizontalBox::Slot()
+                        .AutoWidth()
+                        [
+                            SNew(SButton)
+                                .VAlign(EVerticalAlignment::VAlign_Center)
+                                .Text(IsForExport ? LOCTEXT("ExportButton", "Export") : LOCTEXT("ImportButton", "Import"))
+                                .IsEnabled_Lambda([this]() { return !RunningExportTask.IsValid(); })
+                                .OnClicked_Raw(this, IsForExport ? &SSettingsManagerWindow::DoExport : &SSettingsManagerWindow::DoImport)
+                        ]
                 ]
         ];
 
-    const TSharedRef<SVerticalBox> CategoriesAndSections = SNew(SVerticalBox);
-    for (auto& [CategoryName, CategoryData] : SettingsDataToUse)
+    // only the rows in view get widgets, so the tab stays cheap no matter how many sections are registered
+    TArray<FTreeItemPtr>& RootItems = TreeRootItems[TabIndex];
+    FTabSearch& Search = TabSearches[TabIndex];
+    RootItems.Empty(Table.Categories.Num());
+    Search = {};
+    Search.Entries.Reserve(Table.Num());
+    Search.Matches.Reserve(Table.Num());
+    for (int32 CategoryIndex = 0; CategoryIndex < Table.Categories.Num(); ++CategoryIndex)
     {
-        auto& Sections = CategoryData.Sections;
-        CategoriesAndSections->AddSlot()
-            .Padding(FMargin{ 10, 5, 5, 5 })
-            [
-                SNew(SCheckBox)
-                    .Padding(FMargin{ 10, 0, 0, 0 })
-                    .Content()
-                    [
-                        SNew(STextBlock)
-                            .Text(CategoryData.DisplayName)
-                            .ColorAndOpacity(FColor::Turquoise)
-                    ]
-                    .OnCheckStateChanged_Lambda([&Sections](ECheckBoxState State)
-                        {
-                            for (auto& [_, SectionData] : Sections)
-                            {
-                                SectionData.CheckBoxState = State;
-                            }
-                        })
-                    .IsChecked_Lambda([&Sections]()
-                        {
-                            if (Sections.Num() == 0)
-                            {
-                                return ECheckBoxState::Unchecked;
-                            }
-
-                            const ECheckBoxState State = Sections.begin()->Value.CheckBoxState;
-                            for (const auto& [_, SectionData] : Sections)
-                            {
-                                if (State != SectionData.CheckBoxState)
-                                {
-                                    return ECheckBoxState::Undetermined;
-                                }
-                            }
-                            return State;
-                        })
-            ];
+        const FSectionTable::FCategory& Category = Table.Categories[CategoryIndex];
+        const FTreeItemPtr CategoryItem = MakeShared<FTreeItem>(FTreeItem{ CategoryIndex });
+        CategoryItem->Children.Reserve(Category.NumSections);
 
-        for (auto& [SectionName, SectionData] : Sections)
+        const FString CategorySearchableText = MakeSearchableText(Category.DisplayName, Category.Name);
+        for (int32 SectionIndex = Category.FirstSection; SectionIndex < Category.FirstSection + Category.NumSections; ++SectionIndex)
         {
-            CategoriesAndSections->AddSlot()
-                .Padding(FMargin{ 40, 5, 5, 5 })
-                [
-                    SNew(SCheckBox)
-                        .Padding(FMargin{ 10, 0, 0, 0 })
-                        .Content()
-                        [
-                            SNew(STextBlock)
-                                .Text(SectionData.DisplayName)
-                                .ToolTipText_Lambda([CategoryName, SectionName, LambdaIsSavedProjectBased, TabIndex]()
-                                    {
-                                        if (const bool IsProjectBased = LambdaIsSavedProjectBased(CategoryName, SectionName);
-                                            (TabIndex == 0 && IsProjectBased) || (TabIndex == 1 && !IsProjectBased))
-                                        {
-                                            return TabIndex == 0 ?
-                                                LOCTEXT("ProjectSavedSettingsWarning", "This setting is saved at project-level.") :
-                                                LOCTEXT("EditorSavedSettingsWarning", "This setting is saved at editor-level.");
-                                        }
-
-                                        if (TabIndex == 0 && CategoryName == "General")
-                                        {
-                                            if (SectionName == "Appearance")
-                                            {
-                                                return LOCTEXT("GeneralAppearanceFalseNegativeNote", "This setting will be indicated as a failure even if it succeeds.");
-                                            }
-
-                                            if (SectionName == "InputBindings")
-                                            {
-                                                return LOCTEXT("GeneralInputBindingsFalseNegativeNote", "This setting will fail if there's no modification from the engine default.");
-                                            }
-                                        }
-
-                                        return FText::GetEmpty();
-                                    })
-                                .ColorAndOpacity_Lambda([CategoryName, SectionName, LambdaIsSavedProjectBased, TabIndex]() -> FSlateColor
-                                    {
-                                        if (const bool IsProjectBased = LambdaIsSavedProjectBased(CategoryName, SectionName);
-                                            (TabIndex == 0 && IsProjectBased) || (TabIndex == 1 && !IsProjectBased))
-                                        {
-                                            return FLinearColor::Yellow;
-                                        }
-
-                                        if (IsForExport && TabIndex == 0 && CategoryName == "General" && (SectionName == "Appearance" || SectionName == "InputBindings"))
-                                        {
-                                            return FColor::Magenta;
-                                        }
-
-                                        return FLinearColor::White;
-                                    })
-                        ]
-                        .OnCheckStateChanged_Lambda([&SectionData](ECheckBoxState State)
-                            {
-                                SectionData.CheckBoxState = State;
-                            })
-                        .IsChecked_Lambda([&SectionData]()
-                            {
-                                return SectionData.CheckBoxState;
-                            })
-                ];
+            const FTreeItemPtr SectionItem = MakeShared<FTreeItem>(FTreeItem{ CategoryIndex, SectionIndex });
+            CategoryItem->Children.Add(SectionItem);
+
+            Search.Matches.Add(Search.Entries.Num());
+            Search.Entries.Add({ CategorySearchableText + TEXT('\n') + MakeSearchableText(Table.SectionDisplayNames[SectionIndex], Table.SectionNames[SectionIndex]),
+                CategoryItem, SectionItem });
         }
+        CategoryItem->VisibleChildren = CategoryItem->Children;
+        RootItems.Add(CategoryItem);
     }
+    VisibleRootItems[TabIndex] = RootItems;
 
-    const TSharedRef<SScrollBox> Scroll = SNew(SScrollBox);
-    Scroll->SetOrientation(EOrientation::Orient_Vertical);
-    Scroll->AddSlot()
+    VerticalBox->AddSlot()
+        .AutoHeight()
+        .Padding(10, 0, 10, 5)
         [
-            CategoriesAndSections
+            SNew(SSearchBox)
+                .HintText(LOCTEXT("SearchHint", "Search categories and sections"))
+                .OnTextChanged(this, &SSettingsManagerWindow::HandleSearchTextChanged, TabIndex)
         ];
 
+    const TSharedRef<STreeView<FTreeItemPtr>> TreeView = SNew(STreeView<FTreeItemPtr>)
+        .TreeItemsSource(&VisibleRootItems[TabIndex])
+        .SelectionMode(ESelectionMode::None)
+        .OnGenerateRow(this, &SSettingsManagerWindow::OnGenerateRow<IsForExport>, TabIndex)
+        .OnGetChildren_Lambda([](FTreeItemPtr Item, TArray<FTreeItemPtr>& OutChildren)
+            {
+                OutChildren = Item->VisibleChildren;
+            });
+
+    for (const FTreeItemPtr& CategoryItem : RootItems)
+    {
+        TreeView->SetItemExpansion(CategoryItem, true);
+    }
+    TreeViews[TabIndex] = TreeView;
+
     VerticalBox->AddSlot()
         [
-            Scroll
+            TreeView
         ];
 
     return VerticalBox;
 }
 
-FReply SSettingsManagerWindow::DoExport()
+int32 SSettingsManagerWindow::FSectionTable::FindCategory(FName CategoryName) const
 {
-    const TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().FindWidgetWindow(AsShared());
-    const void* ParentWindowHandle =
-        ParentWindow.IsValid() && ParentWindow->GetNativeWindow().IsValid() ?
-        ParentWindow->GetNativeWindow()->GetOSWindowHandle() :
-        nullptr;
+    return Categories.IndexOfByPredicate([CategoryName](const FCategory& Category) { return Category.Name == CategoryName; });
+}
 
-    FString OutFolder;
-    if (!FDesktopPlatformModule::Get()->OpenDirectoryDialog(ParentWindowHandle,
-        LOCTEXT("ExportSettingsDialogTitle", "Export settings to...").ToString(),
-        FPaths::GetPath(GEditorSettingsIni), OutFolder))
-    {
-        return FReply::Handled();
-    }
+void SSettingsManagerWindow::FSectionTable::FindFalsePositiveSections(const TSharedPtr<ISettingsContainer>& Container)
+{
+    // the other sections export their config object, which can't fail, and only a custom exporter reports these wrongly
+    const TSharedPtr<ISettingsCategory> GeneralCategory = Container->GetCategory("General");
+    const auto FindCustomExportedSection = [this, &GeneralCategory](FName SectionName)
+        {
+            const TSharedPtr<ISettingsSection> Section = GeneralCategory.IsValid() ? GeneralCategory->GetSection(SectionName) : nullptr;
+            return Section.IsValid() && Section->OnExport().IsBound() ? FindSection("General", SectionName) : INDEX_NONE;
+        };
 
-    const ISettingsContainerPtr& SettingsContainer = SettingsContainers[CurrentTabIndex];
+    AppearanceSection = FindCustomExportedSection("Appearance");
+    InputBindingsSection = FindCustomExportedSection("InputBindings");
+}
 
-    TArray<FText> FailedExports;
-    for (const auto& [CategoryName, CategoryData] : SettingsDataToExport[CurrentTabIndex])
+int32 SSettingsManagerWindow::FSectionTable::FindSection(FName CategoryName, FName SectionName) const
+{
+    const int32 CategoryIndex = FindCategory(CategoryName);
+    if (CategoryIndex == INDEX_NONE)
     {
-        const TSharedPtr<ISettingsCategory> Category = SettingsContainer->GetCategory(CategoryName);
-        check(Category.IsValid());
-
-        FString Folder = FPaths::RemoveDuplicateSlashes(FString::Printf(TEXT("%s/%s"), *OutFolder, *CategoryName.ToString()));
-        if (!FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*Folder))
-        {
-            FailedExports.Add(FText::Format(LOCTEXT("FailedToCreateDirectory", "Failed to create directory {0}"), FText::FromString(OutFolder)));
-            continue;
-        }
+        return INDEX_NONE;
+    }
 
-        for (const auto& [SectionName, SectionData] : CategoryData.Sections)
+    const FCategory& Category = Categories[CategoryIndex];
+    for (int32 SectionIndex = Category.FirstSection; SectionIndex < Category.FirstSection + Category.NumSections; ++SectionIndex)
+    {
+        if (SectionNames[SectionIndex] == SectionName)
         {
-            if (SectionData.CheckBoxState != ECheckBoxState::Checked)
-            {
-                continue;
-            }
-
-            const TSharedPtr<ISettingsSection> Section = Category->GetSection(SectionName);
-            check(Section.IsValid());
-
-            FString FileName = FPaths::RemoveDuplicateSlashes(FString::Printf(TEXT("%s/%s.ini"), *Folder, *SectionName.ToString()));
-            //if (Section->CanSaveDefaults())
-            //{
-            //    if (const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
-            //        SettingsObject.IsValid())
-            //    {
-            //        if (SettingsObject->TryUpdateDefaultConfigFile(FileName))
-            //        {
-            //            SettingsObject->ReloadConfig(nullptr, *FileName, UE::LCPF_PropagateToInstances);
-            //            continue;
-            //        }
-            //    }
-            //}
-            if (!Section->Export(FileName))
-            {
-                FailedExports.Add(FText::Format(FText::FromString("{0}/{1}"), CategoryData.DisplayName, SectionData.DisplayName));
-            }
+            return SectionIndex;
         }
     }
+    return INDEX_NONE;
+}
 
-    if (FailedExports.Num() == 0)
-    {
-        ShowNotification(LOCTEXT("ExportSettingsSuccess", "Export settings succeeded"), SNotificationItem::CS_Success);
-    }
-    else
+SSettingsManagerWindow::FSelectionCounts SSettingsManagerWindow::FSectionTable::CountSelection(int32 CategoryIndex) const
+{
+    const FCategory& Category = Categories[CategoryIndex];
+    const int32 EndSection = Category.FirstSection + Category.NumSections;
+
+    FSelectionCounts Counts;
+    Counts.NumTotal = Category.NumSections;
+    Counts.NumChecked = CheckedSections.CountSetBits(Category.FirstSection, EndSection);
+    for (TConstSetBitIterator<> It(ReverseLevelSections, Category.FirstSection); It && It.GetIndex() < EndSection; ++It)
     {
-        const FText Msg = FText::Format(LOCTEXT("ExportSettingsFailure", "Export settings failed for:\n{0}"),
-            FText::Join(FText::FromString("\n"), FailedExports));
-        UE_LOG(LogConfig, Error, TEXT("%s"), *Msg.ToString());
-        ShowNotification(Msg, SNotificationItem::CS_Fail);
+        Counts.NumCheckedAtReverseLevel += CheckedSections[It.GetIndex()] ? 1 : 0;
     }
-
-    return FReply::Handled();
+    return Counts;
 }
 
-FReply SSettingsManagerWindow::DoImport()
+void SSettingsManagerWindow::HandleSearchTextChanged(const FText& SearchText, int TabIndex)
 {
-    const ISettingsContainerPtr SettingsContainer = SettingsContainers[CurrentTabIndex];
+    FTabSearch& Search = TabSearches[TabIndex];
 
-    TArray<FText> FailedImports;
-    for (const auto& [CategoryName, CategoryData] : SettingsDataToImport[CurrentTabIndex])
+    FString Query = SearchText.ToString().TrimStartAndEnd().ToLower();
+    if (Query == Search.Query)
     {
-        const TSharedPtr<ISettingsCategory> Category = SettingsContainer->GetCategory(CategoryName);
-        check(Category.IsValid());
+        return;
+    }
 
-        for (const auto& [SectionName, SectionData] : CategoryData.Sections)
+    // typing more only narrows the previous matches down, so only those need to be checked again
+    TArray<int32> Matches;
+    if (Query.Contains(Search.Query))
+    {
+        Matches.Reserve(Search.Matches.Num());
+        for (const int32 EntryIndex : Search.Matches)
         {
-            if (SectionData.CheckBoxState != ECheckBoxState::Checked)
+            if (Search.Entries[EntryIndex].SearchableText.Contains(Query, ESearchCase::CaseSensitive))
             {
-                continue;
+                Matches.Add(EntryIndex);
             }
+        }
+    }
+    else
+    {
+        for (int32 EntryIndex = 0; EntryIndex < Search.Entries.Num(); ++EntryIndex)
+        {
+            if (Search.Entries[EntryIndex].SearchableText.Contains(Query, ESearchCase::CaseSensitive))
+            {
+                Matches.Add(EntryIndex);
+            }
+        }
+    }
 
-            const TSharedPtr<ISettingsSection> Section = Category->GetSection(SectionName);
-            check(Section.IsValid());
-
-            //if (Section->CanResetDefaults())
-            //{
-            //    if (const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
-            //        SettingsObject.IsValid())
-            //    {
-            //        const FString ConfigName = SettingsObject->GetClass()->GetConfigName();
+    Search.Matches = MoveTemp(Matches);
+    Search.Query = MoveTemp(Query);
 
-            //        GConfig->EmptySection(*SettingsObject->GetClass()->GetPathName(), ConfigName);
-            //        GConfig->Flush(false);
+    UpdateVisibleItems(TabIndex);
+}
 
-            //        FConfigContext::ForceReloadIntoGConfig().Load(*FPaths::GetBaseFilename(ConfigName));
+void SSettingsManagerWindow::UpdateVisibleItems(int TabIndex)
+{
+    const FTabSearch& Search = TabSearches[TabIndex];
 
-            //        SettingsObject->ReloadConfig(nullptr, FileName, UE::LCPF_PropagateToInstances | UE::LCPF_PropagateToChildDefaultObjects);
+    for (const FTreeItemPtr& CategoryItem : TreeRootItems[TabIndex])
+    {
+        CategoryItem->VisibleChildren.Reset();
+    }
 
-            //        return true;
-            //    }
-            //}
+    // the entries are in tree order, so each category's matches are contiguous
+    TArray<FTreeItemPtr>& VisibleItems = VisibleRootItems[TabIndex];
+    VisibleItems.Reset();
+    for (const int32 EntryIndex : Search.Matches)
+    {
+        const FSearchEntry& Entry = Search.Entries[EntryIndex];
+        if (Entry.SectionItem->IsUnchanged)
+        {
+            continue;
+        }
 
-            if (!Section->Import(SectionData.FilePath) || !Section->Save())
-            {
-                FailedImports.Add(FText::Format(FText::FromString("{0}/{1}"), CategoryData.DisplayName, SectionData.DisplayName));
-            }
+        if (VisibleItems.IsEmpty() || VisibleItems.Last() != Entry.CategoryItem)
+        {
+            VisibleItems.Add(Entry.CategoryItem);
         }
+        Entry.CategoryItem->VisibleChildren.Add(Entry.SectionItem);
     }
 
-    if (FailedImports.Num() == 0)
+    TreeViews[TabIndex]->RequestTreeRefresh();
+}
+
+template<bool IsForExport>
+TSharedRef<ITableRow> SSettingsManagerWindow::OnGenerateRow(FTreeItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable, int TabIndex)
+{
+    FSectionTable& Table = SectionTables[TabIndex];
+    const int32 CategoryIndex = Item->CategoryIndex;
+    const int32 SectionIndex = Item->SectionIndex;
+
+    const TSharedRef<STableRow<FTreeItemPtr>> Row = SNew(STableRow<FTreeItemPtr>, OwnerTable)
+        .ShowSelection(false)
+        .Padding(FMargin{ 5, 5, 5, 5 });
+
+    TSharedPtr<SWidget> CheckBox;
+    if (SectionIndex == INDEX_NONE)
     {
-        ShowNotification(LOCTEXT("ImportSettingsSuccess", "Import settings succeeded"), SNotificationItem::CS_Success);
+        CheckBox = SNew(SCheckBox)
+            .Padding(FMargin{ 10, 0, 0, 0 })
+            .Content()
+            [
+                SNew(STextBlock)
+                    .Text(Table.Categories[CategoryIndex].DisplayName)
+                    .ColorAndOpacity(FColor::Turquoise)
+            ]
+            .OnCheckStateChanged_Lambda([this, CategoryIndex, TabIndex](ECheckBoxState State)
+                {
+                    SetCategoryCheckBoxState(TabIndex, CategoryIndex, State);
+                })
+            .IsChecked_Lambda([&Table, CategoryIndex]()
+                {
+                    return Table.Categories[CategoryIndex].SelectionCounts.GetCheckBoxState();
+                });
     }
     else
     {
-        const FText Msg = FText::Format(LOCTEXT("ImportSettingsFailure", "Import settings failed for:\n{0}"),
-            FText::Join(FText::FromString("\n"), FailedImports));
-        UE_LOG(LogConfig, Error, TEXT("%s"), *Msg.ToString());
-        ShowNotification(Msg, SNotificationItem::CS_Fail);
-    }
+        const FName SectionName = Table.SectionNames[SectionIndex];
+        const bool IsEditorTab = SettingsContainers[TabIndex]->GetName() == EditorContainerName;
+        const bool IsFalsePositive = IsForExport && IsEditorTab && (SectionIndex == Table.AppearanceSection || SectionIndex == Table.InputBindingsSection);
+        CheckBox = SNew(SCheckBox)
+            .Padding(FMargin{ 10, 0, 0, 0 })
+            .Content()
+            [
+                SNew(STextBlock)
+                    .Text(Table.SectionDisplayNames[SectionIndex])
+                    .ToolTipText_Lambda([&Table, Item, SectionName, IsEditorTab, IsFalsePositive]()
+                        {
+                            if (Item->SectionIndex != INDEX_NONE && Table.ReverseLevelSections[Item->SectionIndex])
+                            {
+                                return IsEditorTab ?
+                                    LOCTEXT("ProjectSavedSettingsWarning", "This setting is saved at project-level.") :
+                                    LOCTEXT("EditorSavedSettingsWarning", "This setting is saved at editor-level.");
+                            }
 
-    return FReply::Handled();
-}
+                            if (IsFalsePositive)
+                            {
+                                if (SectionName == "Appearance")
+                                {
+                                    return LOCTEXT("GeneralAppearanceFalseNegativeNote", "This setting will be indicated as a failure even if it succeeds.");
+                                }
 
-EVisibility SSettingsManagerWindow::GetTabVisibility(int Index) const
-{
-    return Index == CurrentTabIndex ? EVisibility::Visible : EVisibility::Collapsed;
+                                if (SectionName == "InputBindings")
+                                {
+                                    return LOCTEXT("GeneralInputBindingsFalseNegativeNote", "This setting will fail if there's no modification from the engine default.");
+                                }
+                            }
+
+                            return FText::GetEmpty();
+                        })
+                    .ColorAndOpacity_Lambda([&Table, Item, IsFalsePositive]() -> FSlateColor
+                        {
+                            if (Item->SectionIndex != INDEX_NONE && Table.ReverseLevelSections[Item->SectionIndex])
+                            {
+                                return FLinearColor::Yellow;
+                            }
+
+                            if (IsFalsePositive)
+                            {
+                                return FColor::Magenta;
+                            }
+
+                            return FLinearColor::White;
+                        })
+            ]
+            // the section's index shifts when sections of the categories before it are registered or unregistered, so it's read from the item
+            .OnCheckStateChanged_Lambda([this, Item, TabIndex](ECheckBoxState State)
+                {
+                    if (Item->SectionIndex != INDEX_NONE)
+                    {
+                        SetSectionCheckBoxState(TabIndex, Item->SectionIndex, State);
+                    }
+                })
+            .IsChecked_Lambda([&Table, Item]()
+                {
+                    return Item->SectionIndex != INDEX_NONE && Table.CheckedSections[Item->SectionIndex] ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+                });
+    }
+
+    TSharedRef<SWidget> DifferencesText = SNullWidget::NullWidget;
+    if constexpr (!IsForExport)
+    {
+        if (SectionIndex != INDEX_NONE)
+        {
+            if (const TOptional<TArray<FSettingsKeyDiff>>& SectionDifferences = Table.SectionDifferences[SectionIndex];
+                SectionDifferences.IsSet())
+            {
+                const TArray<FSettingsKeyDiff>& Differences = SectionDifferences.GetValue();
+
+                constexpr int32 MaxListedDifferences = 50;
+                TArray<FString> Lines;
+                for (int32 Index = 0; Index < FMath::Min(Differences.Num(), MaxListedDifferences); ++Index)
+                {
+                    const FSettingsKeyDiff& Diff = Differences[Index];
+                    Lines.Add(FString::Printf(TEXT("[%s] %s: %s -> %s"), *Diff.IniSectionName, *Diff.Key.ToString(),
+                        Diff.CurrentValue.IsSet() ? *Diff.CurrentValue.GetValue() : TEXT("(unset)"),
+                        *Diff.IncomingValue));
+                }
+                if (Differences.Num() > MaxListedDifferences)
+                {
+                    Lines.Add(FString::Printf(TEXT("... and %d more"), Differences.Num() - MaxListedDifferences));
+                }
+
+                DifferencesText = SNew(STextBlock)
+                    .Text(FText::Format(LOCTEXT("NumChangedKeys", "{0} {0}|plural(one=key,other=keys) changed"), Differences.Num()))
+                    .ToolTipText(FText::FromString(FString::Join(Lines, TEXT("\n"))))
+                    .ColorAndOpacity(FLinearColor::Gray);
+            }
+        }
+    }
+
+    Row->SetContent(
+        SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            [
+                SNew(SExpanderArrow, Row)
+                    .IndentAmount(30)
+            ]
+            + SHorizontalBox::Slot()
+            .FillWidth(1.f)
+            [
+                CheckBox.ToSharedRef()
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(10, 0)
+            [
+                DifferencesText
+            ]
+    );
+
+    return Row;
+}
+
+void SSettingsManagerWindow::SetSectionCheckBoxState(int TabIndex, int32 SectionIndex, ECheckBoxState State)
+{
+    FSectionTable& Table = SectionTables[TabIndex];
+
+    const bool IsChecked = State == ECheckBoxState::Checked;
+    if (Table.CheckedSections[SectionIndex] == IsChecked)
+    {
+        return;
+    }
+    Table.CheckedSections[SectionIndex] = IsChecked;
+
+    FSelectionCounts& CategoryCounts = Table.Categories[Table.SectionCategories[SectionIndex]].SelectionCounts;
+    const int32 Delta = IsChecked ? 1 : -1;
+    CategoryCounts.NumChecked += Delta;
+    TabSelectionCounts[TabIndex].NumChecked += Delta;
+
+    if (Table.ReverseLevelSections[SectionIndex])
+    {
+        CategoryCounts.NumCheckedAtReverseLevel += Delta;
+        TabSelectionCounts[TabIndex].NumCheckedAtReverseLevel += Delta;
+    }
+}
+
+void SSettingsManagerWindow::SetCategoryCheckBoxState(int TabIndex, int32 CategoryIndex, ECheckBoxState State)
+{
+    FSectionTable& Table = SectionTables[TabIndex];
+    FSectionTable::FCategory& Category = Table.Categories[CategoryIndex];
+
+    // the whole range ends up in the same state, so its counts follow from the category's totals
+    const bool IsChecked = State == ECheckBoxState::Checked;
+    Table.CheckedSections.SetRange(Category.FirstSection, Category.NumSections, IsChecked);
+
+    FSelectionCounts Counts;
+    Counts.NumTotal = Category.NumSections;
+    Counts.NumChecked = IsChecked ? Category.NumSections : 0;
+    Counts.NumCheckedAtReverseLevel = IsChecked ? Category.NumAtReverseLevel : 0;
+
+    FSelectionCounts& TabCounts = TabSelectionCounts[TabIndex];
+    TabCounts.NumChecked += Counts.NumChecked - Category.SelectionCounts.NumChecked;
+    TabCounts.NumCheckedAtReverseLevel += Counts.NumCheckedAtReverseLevel - Category.SelectionCounts.NumCheckedAtReverseLevel;
+    Category.SelectionCounts = Counts;
+}
+
+TSharedRef<SWidget> SSettingsManagerWindow::MakePresetsMenu()
+{
+    FMenuBuilder MenuBuilder(true, nullptr);
+
+    const TArray<FString> PresetNames = FSettingsPresets::GetPresetNames();
+
+    MenuBuilder.BeginSection("ApplyPreset", LOCTEXT("ApplyPresetSection", "Apply"));
+    for (const FString& PresetName : PresetNames)
+    {
+        MenuBuilder.AddMenuEntry(FText::FromString(PresetName),
+            LOCTEXT("ApplyPresetTooltip", "Select exactly the sections of this preset."),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SSettingsManagerWindow::ApplyPreset, PresetName)));
+    }
+    MenuBuilder.EndSection();
+
+    MenuBuilder.BeginSection("SavePreset", LOCTEXT("SavePresetSection", "Save"));
+    MenuBuilder.AddWidget(
+        SNew(SEditableTextBox)
+            .MinDesiredWidth(200.f)
+            .HintText(LOCTEXT("SavePresetHint", "Save the selection as..."))
+            .OnTextCommitted_Lambda([this](const FText& Text, ETextCommit::Type CommitType)
+                {
+                    if (CommitType == ETextCommit::OnEnter)
+                    {
+                        SaveSelectionAsPreset(Text.ToString().TrimStartAndEnd());
+                        FSlateApplication::Get().DismissAllMenus();
+                    }
+                }),
+        FText::GetEmpty());
+    MenuBuilder.EndSection();
+
+    if (PresetNames.Num() > 0)
+    {
+        MenuBuilder.BeginSection("DeletePreset");
+        MenuBuilder.AddSubMenu(LOCTEXT("DeletePresetSubMenu", "Delete"), FText::GetEmpty(),
+            FNewMenuDelegate::CreateLambda([PresetNames](FMenuBuilder& SubMenuBuilder)
+                {
+                    for (const FString& PresetName : PresetNames)
+                    {
+                        SubMenuBuilder.AddMenuEntry(FText::FromString(PresetName), FText::GetEmpty(), FSlateIcon(),
+                            FUIAction(FExecuteAction::CreateLambda([PresetName]() { FSettingsPresets::DeletePreset(PresetName); })));
+                    }
+                }));
+        MenuBuilder.EndSection();
+    }
+
+    return MenuBuilder.MakeWidget();
+}
+
+void SSettingsManagerWindow::ApplyPreset(FString PresetName)
+{
+    TSet<FSettingsSectionKey> Keys;
+    if (!FSettingsPresets::LoadPreset(PresetName, Keys))
+    {
+        return;
+    }
+
+    // kept for the tabs that aren't built yet
+    AppliedPreset = MoveTemp(Keys);
+
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        if (!TabWidgets[TabIndex].IsValid())
+        {
+            continue;
+        }
+
+        const FName ContainerName = SettingsContainers[TabIndex]->GetName();
+        const FSectionTable& Table = SectionTables[TabIndex];
+        for (int32 SectionIndex = 0; SectionIndex < Table.Num(); ++SectionIndex)
+        {
+            const FSettingsSectionKey Key{ ContainerName, Table.Categories[Table.SectionCategories[SectionIndex]].Name, Table.SectionNames[SectionIndex] };
+            SetSectionCheckBoxState(TabIndex, SectionIndex, AppliedPreset->Contains(Key) ? ECheckBoxState::Checked : ECheckBoxState::Unchecked);
+        }
+    }
+}
+
+void SSettingsManagerWindow::SaveSelectionAsPreset(const FString& PresetName)
+{
+    // the tabs that were never shown keep what the preset already had for their container
+    TSet<FSettingsSectionKey> Keys;
+    FSettingsPresets::LoadPreset(PresetName, Keys);
+
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        if (!TabWidgets[TabIndex].IsValid())
+        {
+            continue;
+        }
+
+        const FName ContainerName = SettingsContainers[TabIndex]->GetName();
+        for (auto It = Keys.CreateIterator(); It; ++It)
+        {
+            if (It->ContainerName == ContainerName)
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        const FSectionTable& Table = SectionTables[TabIndex];
+        for (TConstSetBitIterator<> It(Table.CheckedSections); It; ++It)
+        {
+            Keys.Add({ ContainerName, Table.Categories[Table.SectionCategories[It.GetIndex()]].Name, Table.SectionNames[It.GetIndex()] });
+        }
+    }
+
+    if (FSettingsPresets::SavePreset(PresetName, Keys))
+    {
+        ShowNotification(FText::Format(LOCTEXT("SavePresetSuccess", "Saved preset {0}"), FText::FromString(PresetName)), SNotificationItem::CS_Success);
+    }
+    else
+    {
+        ShowNotification(LOCTEXT("SavePresetFailure", "A preset name can't be empty nor contain '|'"), SNotificationItem::CS_Fail);
+    }
+}
+
+void SSettingsManagerWindow::HandleCategoryModified(const FName& CategoryName, int TabIndex)
+{
+    // a tab that isn't built yet lists the sections registered by the time it's first shown
+    if (!TabWidgets[TabIndex].IsValid())
+    {
+        return;
+    }
+
+    if (ImportManifest.IsValid())
+    {
+        UpdateCategory<false>(TabIndex, CategoryName);
+    }
+    else
+    {
+        UpdateCategory<true>(TabIndex, CategoryName);
+    }
+}
+
+template<bool IsForExport>
+void SSettingsManagerWindow::UpdateCategory(int TabIndex, FName CategoryName)
+{
+    const TSharedPtr<ISettingsContainer>& SettingsContainer = SettingsContainers[TabIndex];
+    const TSharedPtr<ISettingsCategory> SettingsCategory = SettingsContainer->GetCategory(CategoryName);
+
+    FSettingsCategorySections CategorySections;
+    if (SettingsCategory.IsValid())
+    {
+        if constexpr (IsForExport)
+        {
+            CategorySections = FSettingsManagerOperations::GetExportableSections(SettingsCategory);
+        }
+        else
+        {
+            const FSettingsSectionFilter CategoryFilter{ { CategoryName.ToString() } };
+            for (FSettingsCategorySections& ImportableSections : FSettingsManagerOperations::GetImportableSections(SettingsContainer, *ImportManifest, CategoryFilter))
+            {
+                CategorySections = MoveTemp(ImportableSections);
+            }
+        }
+    }
+
+    FSectionTable& Table = SectionTables[TabIndex];
+    TArray<FTreeItemPtr>& RootItems = TreeRootItems[TabIndex];
+
+    int32 CategoryIndex = Table.FindCategory(CategoryName);
+    if (CategoryIndex == INDEX_NONE)
+    {
+        if (CategorySections.Sections.IsEmpty())
+        {
+            return;
+        }
+
+        // kept even if all its sections get unregistered later on, so that the indices of the categories never change
+        CategoryIndex = Table.Categories.Add({ CategoryName, SettingsCategory->GetDisplayName(), Table.Num() });
+        const FTreeItemPtr CategoryItem = MakeShared<FTreeItem>(FTreeItem{ CategoryIndex });
+        RootItems.Add(CategoryItem);
+        TreeViews[TabIndex]->SetItemExpansion(CategoryItem, true);
+    }
+
+    FSectionTable::FCategory& Category = Table.Categories[CategoryIndex];
+    const int32 FirstSection = Category.FirstSection;
+    const int32 OldNumSections = Category.NumSections;
+    const int32 NewNumSections = CategorySections.Sections.Num();
+
+    TMap<FName, int32> OldSectionIndices;
+    OldSectionIndices.Reserve(OldNumSections);
+    for (int32 SectionIndex = FirstSection; SectionIndex < FirstSection + OldNumSections; ++SectionIndex)
+    {
+        OldSectionIndices.Add(Table.SectionNames[SectionIndex], SectionIndex);
+    }
+
+    // the new rows are gathered first, carrying over the check state of the sections still registered
+    const FName ContainerName = SettingsContainer->GetName();
+    TArray<FName> SectionNames;
+    TArray<FText> SectionDisplayNames;
+    TBitArray<> CheckedSections;
+    TBitArray<> ReverseLevelSections;
+    SectionNames.Reserve(NewNumSections);
+    SectionDisplayNames.Reserve(NewNumSections);
+    for (const TSharedPtr<ISettingsSection>& Section : CategorySections.Sections)
+    {
+        const FName SectionName = Section->GetName();
+        const int32* OldSectionIndex = OldSectionIndices.Find(SectionName);
+
+        SectionNames.Add(SectionName);
+        SectionDisplayNames.Add(Section->GetDisplayName());
+        ReverseLevelSections.Add(IsSavedAtReverseLevel(ContainerName, IsSectionSavedProjectBased(Section)));
+        if (OldSectionIndex != nullptr)
+        {
+            CheckedSections.Add(Table.CheckedSections[*OldSectionIndex]);
+        }
+        else
+        {
+            CheckedSections.Add(AppliedPreset.IsSet() ? AppliedPreset->Contains({ ContainerName, CategoryName, SectionName }) : !IsForExport);
+        }
+    }
+
+    // splice the category's range, and shift the ranges after it
+    Table.SectionNames.RemoveAt(FirstSection, OldNumSections);
+    Table.SectionNames.Insert(SectionNames, FirstSection);
+    Table.SectionDisplayNames.RemoveAt(FirstSection, OldNumSections);
+    Table.SectionDisplayNames.Insert(SectionDisplayNames, FirstSection);
+    Table.SectionCategories.RemoveAt(FirstSection, OldNumSections);
+    Table.SectionCategories.InsertZeroed(FirstSection, NewNumSections);
+    Table.CheckedSections.RemoveAt(FirstSection, OldNumSections);
+    Table.CheckedSections.Insert(false, FirstSection, NewNumSections);
+    Table.ReverseLevelSections.RemoveAt(FirstSection, OldNumSections);
+    Table.ReverseLevelSections.Insert(false, FirstSection, NewNumSections);
+    if constexpr (!IsForExport)
+    {
+        Table.SectionFilePaths.RemoveAt(FirstSection, OldNumSections);
+        Table.SectionFilePaths.Insert(CategorySections.FilePaths, FirstSection);
+        // the differences of a modified category may be outdated, so they're computed again on demand
+        Table.SectionDifferences.RemoveAt(FirstSection, OldNumSections);
+        Table.SectionDifferences.InsertDefaulted(FirstSection, NewNumSections);
+    }
+
+    Category.NumAtReverseLevel = 0;
+    for (int32 Index = 0; Index < NewNumSections; ++Index)
+    {
+        Table.SectionCategories[FirstSection + Index] = CategoryIndex;
+        Table.CheckedSections[FirstSection + Index] = CheckedSections[Index];
+        Table.ReverseLevelSections[FirstSection + Index] = ReverseLevelSections[Index];
+        Category.NumAtReverseLevel += ReverseLevelSections[Index] ? 1 : 0;
+    }
+    Category.NumSections = NewNumSections;
+    // splicing moves the sections of the categories after this one too
+    Table.FindFalsePositiveSections(SettingsContainers[TabIndex]);
+
+    const int32 Delta = NewNumSections - OldNumSections;
+    for (int32 Index = CategoryIndex + 1; Index < Table.Categories.Num(); ++Index)
+    {
+        Table.Categories[Index].FirstSection += Delta;
+        for (const FTreeItemPtr& SectionItem : RootItems[Index]->Children)
+        {
+            SectionItem->SectionIndex += Delta;
+        }
+    }
+
+    const FSelectionCounts Counts = Table.CountSelection(CategoryIndex);
+    FSelectionCounts& TabCounts = TabSelectionCounts[TabIndex];
+    TabCounts.NumTotal += Counts.NumTotal - Category.SelectionCounts.NumTotal;
+    TabCounts.NumChecked += Counts.NumChecked - Category.SelectionCounts.NumChecked;
+    TabCounts.NumCheckedAtReverseLevel += Counts.NumCheckedAtReverseLevel - Category.SelectionCounts.NumCheckedAtReverseLevel;
+    Category.SelectionCounts = Counts;
+
+    // there's one search entry per section, in the same order as the table
+    const FTreeItemPtr& CategoryItem = RootItems[CategoryIndex];
+    // the rows of the replaced items are polled until the tree regenerates them, so they're left pointing at no section
+    for (const FTreeItemPtr& SectionItem : CategoryItem->Children)
+    {
+        SectionItem->SectionIndex = INDEX_NONE;
+    }
+    CategoryItem->Children.Reset(NewNumSections);
+    TArray<FSearchEntry> Entries;
+    Entries.Reserve(NewNumSections);
+    const FString CategorySearchableText = MakeSearchableText(Category.DisplayName, Category.Name);
+    for (int32 SectionIndex = FirstSection; SectionIndex < FirstSection + NewNumSections; ++SectionIndex)
+    {
+        const FTreeItemPtr SectionItem = MakeShared<FTreeItem>(FTreeItem{ CategoryIndex, SectionIndex });
+        CategoryItem->Children.Add(SectionItem);
+
+        Entries.Add({ CategorySearchableText + TEXT('\n') + MakeSearchableText(Table.SectionDisplayNames[SectionIndex], Table.SectionNames[SectionIndex]),
+            CategoryItem, SectionItem });
+    }
+
+    FTabSearch& Search = TabSearches[TabIndex];
+    Search.Entries.RemoveAt(FirstSection, OldNumSections);
+    Search.Entries.Insert(MoveTemp(Entries), FirstSection);
+
+    Search.Matches.Reset();
+    for (int32 EntryIndex = 0; EntryIndex < Search.Entries.Num(); ++EntryIndex)
+    {
+        if (Search.Entries[EntryIndex].SearchableText.Contains(Search.Query, ESearchCase::CaseSensitive))
+        {
+            Search.Matches.Add(EntryIndex);
+        }
+    }
+
+    UpdateVisibleItems(TabIndex);
+}
+
+bool SSettingsManagerWindow::IsSectionSavedProjectBased(const TSharedPtr<ISettingsSection>& Section)
+{
+    const TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+    return SettingsObject.IsValid() && SettingsObject->GetClass()->HasAnyClassFlags(CLASS_DefaultConfig);
+}
+
+bool SSettingsManagerWindow::IsSavedAtReverseLevel(FName ContainerName, bool IsProjectBased)
+{
+    // other containers have no level of their own to compare with
+    return (ContainerName == EditorContainerName && IsProjectBased) || (ContainerName == ProjectContainerName && !IsProjectBased);
+}
+
+bool SSettingsManagerWindow::CanProcessAllContainers() const
+{
+    return !ImportManifest.IsValid() || ImportManifest->Archive.IsValid() || !ImportManifest->Containers.IsEmpty();
+}
+
+FText SSettingsManagerWindow::GetTabTitle(int TabIndex) const
+{
+    const TSharedPtr<ISettingsContainer>& SettingsContainer = SettingsContainers[TabIndex];
+    if (SettingsContainer->GetName() == EditorContainerName)
+    {
+        return LOCTEXT("EditorPreferencesTabTitle", "Editor Preferences");
+    }
+    if (SettingsContainer->GetName() == ProjectContainerName)
+    {
+        return LOCTEXT("ProjectSettingsTabTitle", "Project Settings");
+    }
+
+    const FText DisplayName = SettingsContainer->GetDisplayName();
+    return DisplayName.IsEmpty() ? FText::FromName(SettingsContainer->GetName()) : DisplayName;
+}
+
+template<bool IsForExport>
+void SSettingsManagerWindow::GatherCheckedSections(int TabIndex, const FString& Folder, TArray<FSettingsSectionFile>& OutSections, TArray<FText>& OutFailures)
+{
+    const ISettingsContainerPtr& SettingsContainer = SettingsContainers[TabIndex];
+
+    // a tab that was never shown has its default selection: the applied preset, or else nothing to export and everything to import
+    if (!TabWidgets[TabIndex].IsValid())
+    {
+        if (IsForExport && !AppliedPreset.IsSet())
+        {
+            return;
+        }
+
+        TArray<FSettingsCategorySections> CategoriesSections;
+        if constexpr (IsForExport)
+        {
+            CategoriesSections = FSettingsManagerOperations::GetExportableSections(SettingsContainer);
+        }
+        else
+        {
+            CategoriesSections = FSettingsManagerOperations::GetImportableSections(SettingsContainer, *ImportManifest);
+        }
+
+        for (const FSettingsCategorySections& CategorySections : CategoriesSections)
+        {
+            for (int SectionIndex = 0; SectionIndex < CategorySections.Sections.Num(); ++SectionIndex)
+            {
+                const TSharedPtr<ISettingsSection>& Section = CategorySections.Sections[SectionIndex];
+                const FString FilePath = IsForExport ?
+                    FSettingsManagerOperations::GetSectionFilePath(Folder, CategorySections.Category->GetName(), Section->GetName()) :
+                    CategorySections.FilePaths[SectionIndex];
+
+                FSettingsSectionFile SectionFile = FSettingsManagerOperations::MakeSectionFile(SettingsContainer, CategorySections.Category, Section, FilePath);
+                if (!AppliedPreset.IsSet() || AppliedPreset->Contains(SectionFile.Key))
+                {
+                    OutSections.Add(MoveTemp(SectionFile));
+                }
+            }
+        }
+        return;
+    }
+
+    const FSectionTable& Table = SectionTables[TabIndex];
+    OutSections.Reserve(OutSections.Num() + TabSelectionCounts[TabIndex].NumChecked);
+
+    // the checked sections of a category are contiguous, so each category is only looked up once
+    int32 CategoryIndex = INDEX_NONE;
+    TSharedPtr<ISettingsCategory> Category;
+    for (TConstSetBitIterator<> It(Table.CheckedSections); It; ++It)
+    {
+        const int32 SectionIndex = It.GetIndex();
+
+        const FName CategoryName = Table.Categories[Table.SectionCategories[SectionIndex]].Name;
+        const FName SectionName = Table.SectionNames[SectionIndex];
+        if (Table.SectionCategories[SectionIndex] != CategoryIndex)
+        {
+            CategoryIndex = Table.SectionCategories[SectionIndex];
+            Category = SettingsContainer->GetCategory(CategoryName);
+        }
+
+        // the rows are patched as sections come and go, but a section may still be unregistered without its category being notified
+        const TSharedPtr<ISettingsSection> Section = Category.IsValid() ? Category->GetSection(SectionName) : nullptr;
+        if (!Section.IsValid())
+        {
+            OutFailures.Add(FText::Format(LOCTEXT("SectionNoLongerRegistered", "{0}/{1} (no longer registered)"),
+                FText::FromName(CategoryName), FText::FromName(SectionName)));
+            continue;
+        }
+
+        const FString FilePath = IsForExport ? FSettingsManagerOperations::GetSectionFilePath(Folder, CategoryName, SectionName) : Table.SectionFilePaths[SectionIndex];
+        OutSections.Add(FSettingsManagerOperations::MakeSectionFile(SettingsContainer, Category, Section, FilePath));
+    }
+}
+
+FReply SSettingsManagerWindow::DoExport()
+{
+    const TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().FindWidgetWindow(AsShared());
+    const void* ParentWindowHandle =
+        ParentWindow.IsValid() && ParentWindow->GetNativeWindow().IsValid() ?
+        ParentWindow->GetNativeWindow()->GetOSWindowHandle() :
+        nullptr;
+
+    // a second export could write the same files as the running one
+    if (RunningExportTask.IsValid())
+    {
+        return FReply::Handled();
+    }
+
+    const ISettingsContainerPtr& SettingsContainer = SettingsContainers[CurrentTabIndex];
+
+    FString OutFolder;
+    FString ArchivePath;
+    if (ExportAsArchive)
+    {
+        TArray<FString> OutFiles;
+        if (!FDesktopPlatformModule::Get()->SaveFileDialog(ParentWindowHandle,
+            LOCTEXT("ExportSettingsArchiveDialogTitle", "Export settings archive to...").ToString(),
+            FPaths::GetPath(GEditorSettingsIni),
+            (AllContainers ? FString(TEXT("Settings")) : SettingsContainer->GetName().ToString()) + TEXT(".") + FSettingsArchive::Extension,
+            FString::Printf(TEXT("Settings Archive (*.%s)|*.%s"), FSettingsArchive::Extension, FSettingsArchive::Extension),
+            EFileDialogFlags::None, OutFiles) || OutFiles.Num() == 0)
+        {
+            return FReply::Handled();
+        }
+
+        ArchivePath = OutFiles[0];
+        OutFolder = FPaths::GetPath(ArchivePath);
+    }
+    else if (!FDesktopPlatformModule::Get()->OpenDirectoryDialog(ParentWindowHandle,
+        LOCTEXT("ExportSettingsDialogTitle", "Export settings to...").ToString(),
+        FPaths::GetPath(GEditorSettingsIni), OutFolder))
+    {
+        return FReply::Handled();
+    }
+
+    // the config state is gathered here on the game thread, and only the file writes are done on a worker thread
+    TArray<FText> FailedExports;
+    TArray<FSettingsSectionFile> SectionsToExport;
+    TArray<FName> ContainerNames;
+    TArray<FText> SkippedTabs;
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        // a tab that was never shown has nothing selected unless a preset was applied
+        if (AllContainers && TabIndex != CurrentTabIndex && !TabWidgets[TabIndex].IsValid() && !AppliedPreset.IsSet())
+        {
+            SkippedTabs.Add(GetTabTitle(TabIndex));
+            continue;
+        }
+
+        // every container goes into the same task, so that all their files are written in one pass under the same root
+        if (AllContainers || TabIndex == CurrentTabIndex)
+        {
+            const FName ContainerName = SettingsContainers[TabIndex]->GetName();
+            GatherCheckedSections<true>(TabIndex, AllContainers && ArchivePath.IsEmpty() ? FSettingsManagerOperations::GetContainerFolder(OutFolder, ContainerName) : OutFolder,
+                SectionsToExport, FailedExports);
+            ContainerNames.Add(ContainerName);
+        }
+    }
+
+    if (AllContainers && ArchivePath.IsEmpty() && !FSettingsManagerOperations::WriteContainersFile(OutFolder, ContainerNames))
+    {
+        FailedExports.Add(FText::FromString(FPaths::Combine(OutFolder, FSettingsManagerOperations::ContainersFileName)));
+    }
+
+    if (SkippedTabs.Num() > 0)
+    {
+        const FText Msg = FText::Format(LOCTEXT("ExportSettingsSkippedTabs", "Skipped the tabs never shown, which have no sections selected:\n{0}"),
+            FText::Join(FText::FromString("\n"), SkippedTabs));
+        UE_LOG(LogSettingsManager, Warning, TEXT("%s"), *Msg.ToString());
+        ShowNotification(Msg, SNotificationItem::CS_None);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    TArray<FCapturedSettingsSection> CapturedSections = FSettingsManagerOperations::CaptureSections(SectionsToExport, FailedExports);
+
+    const bool IsIncremental = IncrementalExport && ArchivePath.IsEmpty();
+    const TSharedRef<FSettingsExportTask> ExportTask = MakeShared<FSettingsExportTask>(MoveTemp(CapturedSections), MoveTemp(ArchivePath));
+    if (IsIncremental)
+    {
+        ExportTask->SetIncremental(OutFolder);
+    }
+
+    FNotificationInfo ProgressInfo(TAttribute<FText>::CreateLambda([ExportTask]()
+        {
+            return FText::Format(LOCTEXT("ExportSettingsProgress", "Exporting settings... ({0} / {1})"),
+                ExportTask->GetNumProcessed(), ExportTask->GetNumTotal());
+        }));
+    ProgressInfo.bFireAndForget = false;
+    ProgressInfo.ButtonDetails.Add(FNotificationButtonInfo(
+        LOCTEXT("CancelExportButton", "Cancel"),
+        LOCTEXT("CancelExportButtonTooltip", "Stop exporting. The sections already written are kept."),
+        FSimpleDelegate::CreateLambda([ExportTask]() { ExportTask->Cancel(); }),
+        SNotificationItem::CS_Pending));
+
+    const TSharedPtr<SNotificationItem> ProgressNotification = FSlateNotificationManager::Get().AddNotification(ProgressInfo);
+    if (ProgressNotification.IsValid())
+    {
+        ProgressNotification->SetCompletionState(SNotificationItem::CS_Pending);
+    }
+
+    RunningExportTask = ExportTask;
+    ExportTask->Start(FSettingsExportTask::FOnFinished::CreateLambda(
+        [WeakWindow = TWeakPtr<SSettingsManagerWindow>(SharedThis(this)), ProgressNotification, IsIncremental, StartTime,
+            FailedExports = MoveTemp(FailedExports)](const FSettingsExportTask& Task) mutable
+        {
+            FSettingsManagerOperations::ReportResults(TEXT("Export"), Task.GetSectionResults(), Task.GetNumBytesWritten(),
+                FPlatformTime::Seconds() - StartTime);
+
+            if (ProgressNotification.IsValid())
+            {
+                ProgressNotification->SetCompletionState(SNotificationItem::CS_None);
+                ProgressNotification->ExpireAndFadeout();
+            }
+
+            FailedExports.Append(Task.GetFailures());
+
+            if (Task.IsCancelled())
+            {
+                ShowNotification(FText::Format(LOCTEXT("ExportSettingsCancelled", "Export settings cancelled after {0} of {1} sections"),
+                    Task.GetNumProcessed(), Task.GetNumTotal()), SNotificationItem::CS_None);
+            }
+            else if (FailedExports.Num() == 0)
+            {
+                ShowNotification(IsIncremental ?
+                    FText::Format(LOCTEXT("ExportSettingsIncrementalSuccess", "Export settings succeeded\n{0} of {1} sections unchanged"),
+                        Task.GetNumUnchanged(), Task.GetNumTotal()) :
+                    LOCTEXT("ExportSettingsSuccess", "Export settings succeeded"), SNotificationItem::CS_Success);
+            }
+            else
+            {
+                const FText Msg = FText::Format(LOCTEXT("ExportSettingsFailure", "Export settings failed for:\n{0}"),
+                    FText::Join(FText::FromString("\n"), FailedExports));
+                UE_LOG(LogConfig, Error, TEXT("%s"), *Msg.ToString());
+                ShowNotification(Msg, SNotificationItem::CS_Fail);
+            }
+
+            // the tab may have been closed while exporting
+            if (const TSharedPtr<SSettingsManagerWindow> Window = WeakWindow.Pin())
+            {
+                Window->RunningExportTask.Reset();
+            }
+        }));
+
+    return FReply::Handled();
+}
+
+FReply SSettingsManagerWindow::DoImport()
+{
+    // the sections of every container are imported together, so that each config file is only written once
+    const bool IsAllContainers = AllContainers && CanProcessAllContainers();
+    TArray<FText> FailedImports;
+    TArray<FSettingsSectionFile> SectionsToImport;
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        if (IsAllContainers || TabIndex == CurrentTabIndex)
+        {
+            GatherCheckedSections<false>(TabIndex, FString(), SectionsToImport, FailedImports);
+        }
+    }
+
+    const FSettingsImportStats Stats = FSettingsManagerOperations::ImportSections(SectionsToImport, FailedImports, ImportManifest->Archive.Get(),
+        MergeImport ? ESettingsImportMode::Merge : ESettingsImportMode::Overwrite);
+    for (int TabIndex = 0; TabIndex < SettingsContainers.Num(); ++TabIndex)
+    {
+        if (IsAllContainers || TabIndex == CurrentTabIndex)
+        {
+            ClearDifferences(TabIndex);
+        }
+    }
+    UE_LOG(LogSettingsManager, Log, TEXT("Imported %d sections (%d unchanged, %d conflicting keys), writing %d config files in %.1f ms"),
+        Stats.NumSectionsImported, Stats.NumSectionsUnchanged, Stats.NumConflicts, Stats.NumFilesWritten, Stats.ElapsedSeconds * 1000.0);
+
+    int64 NumBytesRead = 0;
+    for (const FSettingsSectionResult& Result : Stats.SectionResults)
+    {
+        NumBytesRead += Result.NumBytes;
+    }
+    FSettingsManagerOperations::ReportResults(TEXT("Import"), Stats.SectionResults, NumBytesRead, Stats.ElapsedSeconds);
+
+    if (FailedImports.Num() == 0)
+    {
+        FText Msg = FText::Format(LOCTEXT("ImportSettingsSuccessWithStats", "Import settings succeeded\n{0} config files written in {1} ms"),
+            Stats.NumFilesWritten, FText::AsNumber(FMath::RoundToInt(Stats.ElapsedSeconds * 1000.0)));
+        if (Stats.NumConflicts > 0)
+        {
+            Msg = FText::Format(LOCTEXT("ImportSettingsConflicts", "{0}\n{1} keys changed on both sides, listed in the log"), Msg, Stats.NumConflicts);
+        }
+        ShowNotification(Msg, SNotificationItem::CS_Success);
+    }
+    else
+    {
+        const FText Msg = FText::Format(LOCTEXT("ImportSettingsFailure", "Import settings failed for:\n{0}"),
+            FText::Join(FText::FromString("\n"), FailedImports));
+        UE_LOG(LogConfig, Error, TEXT("%s"), *Msg.ToString());
+        ShowNotification(Msg, SNotificationItem::CS_Fail);
+    }
+
+    return FReply::Handled();
+}
+
+ECheckBoxState SSettingsManagerWindow::FSelectionCounts::GetCheckBoxState() const
+{
+    if (NumChecked == 0)
+    {
+        return ECheckBoxState::Unchecked;
+    }
+
+    return NumChecked == NumTotal ? ECheckBoxState::Checked : ECheckBoxState::Undetermined;
+}
+
+void SSettingsManagerWindow::ClearDifferences(int TabIndex)
+{
+    if (!TabWidgets[TabIndex].IsValid())
+    {
+        return;
+    }
+
+    FSectionTable& Table = SectionTables[TabIndex];
+    for (TOptional<TArray<FSettingsKeyDiff>>& Differences : Table.SectionDifferences)
+    {
+        Differences.Reset();
+    }
+    for (const FTreeItemPtr& CategoryItem : TreeRootItems[TabIndex])
+    {
+        for (const FTreeItemPtr& SectionItem : CategoryItem->Children)
+        {
+            SectionItem->IsUnchanged = false;
+        }
+    }
+
+    UpdateVisibleItems(TabIndex);
+    TreeViews[TabIndex]->RebuildList();
+}
+
+FReply SSettingsManagerWindow::ShowDifferences()
+{
+    const ISettingsContainerPtr SettingsContainer = SettingsContainers[CurrentTabIndex];
+    FSectionTable& Table = SectionTables[CurrentTabIndex];
+
+    int32 NumChangedSections = 0;
+    for (const FTreeItemPtr& CategoryItem : TreeRootItems[CurrentTabIndex])
+    {
+        const TSharedPtr<ISettingsCategory> Category = SettingsContainer->GetCategory(Table.Categories[CategoryItem->CategoryIndex].Name);
+
+        for (const FTreeItemPtr& SectionItem : CategoryItem->Children)
+        {
+            const int32 SectionIndex = SectionItem->SectionIndex;
+            Table.SectionDifferences[SectionIndex].Reset();
+            SectionItem->IsUnchanged = false;
+
+            const TSharedPtr<ISettingsSection> Section = Category.IsValid() ? Category->GetSection(Table.SectionNames[SectionIndex]) : nullptr;
+            if (!Section.IsValid())
+            {
+                continue;
+            }
+
+            const FSettingsSectionFile SectionFile = FSettingsManagerOperations::MakeSectionFile(SettingsContainer, Category, Section,
+                Table.SectionFilePaths[SectionIndex]);
+
+            FString Contents;
+            TArray<FSettingsKeyDiff> Differences;
+            if (!FSettingsManagerOperations::ReadSectionContents(SectionFile, ImportManifest->Archive.Get(), Contents) ||
+                !FSettingsManagerOperations::DiffSection(SectionFile, Contents, Differences))
+            {
+                continue;
+            }
+
+            SectionItem->IsUnchanged = Differences.IsEmpty();
+            NumChangedSections += Differences.IsEmpty() ? 0 : 1;
+            Table.SectionDifferences[SectionIndex] = MoveTemp(Differences);
+        }
+    }
+
+    UpdateVisibleItems(CurrentTabIndex);
+    // the rows showing the numbers of changed keys have to be generated again
+    TreeViews[CurrentTabIndex]->RebuildList();
+
+    ShowNotification(FText::Format(LOCTEXT("ShowDifferencesResult", "{0} of {1} sections would change"),
+        NumChangedSections, TabSelectionCounts[CurrentTabIndex].NumTotal), SNotificationItem::CS_None);
+
+    return FReply::Handled();
 }
 
 void SSettingsManagerWindow::ShowNotification(const FText& Text, SNotificationItem::ECompletionState CompletionState)
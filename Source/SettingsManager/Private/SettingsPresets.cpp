@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsPresets.h"
+
+#include "Misc/ConfigCacheIni.h"
+
+namespace
+{
+    const TCHAR* const PresetsIniSection = TEXT("SettingsManager");
+    const TCHAR* const PresetsIniKey = TEXT("Presets");
+    const TCHAR* const NameSeparator = TEXT("|");
+}
+
+TArray<FString> FSettingsPresets::GetPresetNames()
+{
+    TArray<FString> Names;
+    for (const FString& Entry : LoadEntries())
+    {
+        FString Name;
+        if (Entry.Split(NameSeparator, &Name, nullptr))
+        {
+            Names.Add(MoveTemp(Name));
+        }
+    }
+    Names.Sort();
+    return Names;
+}
+
+bool FSettingsPresets::LoadPreset(const FString& Name, TSet<FSettingsSectionKey>& OutKeys)
+{
+    OutKeys.Reset();
+
+    const TArray<FString> Entries = LoadEntries();
+    const int32 EntryIndex = FindEntry(Entries, Name);
+    if (EntryIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    TArray<FString> Paths;
+    Entries[EntryIndex].RightChop(Name.Len() + 1).ParseIntoArray(Paths, TEXT(","));
+    for (const FString& Path : Paths)
+    {
+        TArray<FString> Names;
+        if (Path.ParseIntoArray(Names, TEXT("/")) == 3)
+        {
+            OutKeys.Add({ FName{ *Names[0] }, FName{ *Names[1] }, FName{ *Names[2] } });
+        }
+    }
+    return true;
+}
+
+bool FSettingsPresets::SavePreset(const FString& Name, const TSet<FSettingsSectionKey>& Keys)
+{
+    if (Name.IsEmpty() || Name.Contains(NameSeparator))
+    {
+        return false;
+    }
+
+    TArray<FString> Paths;
+    Paths.Reserve(Keys.Num());
+    for (const FSettingsSectionKey& Key : Keys)
+    {
+        Paths.Add(Key.ToString());
+    }
+    // sorted so that saving the same selection again doesn't change the file
+    Paths.Sort();
+
+    FString Entry = Name + NameSeparator + FString::Join(Paths, TEXT(","));
+
+    TArray<FString> Entries = LoadEntries();
+    if (const int32 EntryIndex = FindEntry(Entries, Name);
+        EntryIndex != INDEX_NONE)
+    {
+        Entries[EntryIndex] = MoveTemp(Entry);
+    }
+    else
+    {
+        Entries.Add(MoveTemp(Entry));
+    }
+    SaveEntries(Entries);
+    return true;
+}
+
+void FSettingsPresets::DeletePreset(const FString& Name)
+{
+    TArray<FString> Entries = LoadEntries();
+    if (const int32 EntryIndex = FindEntry(Entries, Name);
+        EntryIndex != INDEX_NONE)
+    {
+        Entries.RemoveAt(EntryIndex);
+        SaveEntries(Entries);
+    }
+}
+
+TArray<FString> FSettingsPresets::LoadEntries()
+{
+    TArray<FString> Entries;
+    GConfig->GetArray(PresetsIniSection, PresetsIniKey, Entries, GEditorSettingsIni);
+    return Entries;
+}
+
+void FSettingsPresets::SaveEntries(const TArray<FString>& Entries)
+{
+    GConfig->SetArray(PresetsIniSection, PresetsIniKey, Entries, GEditorSettingsIni);
+    GConfig->Flush(false, GEditorSettingsIni);
+}
+
+int32 FSettingsPresets::FindEntry(const TArray<FString>& Entries, const FString& Name)
+{
+    const FString Prefix = Name + NameSeparator;
+    return Entries.IndexOfByPredicate([&Prefix](const FString& Entry) { return Entry.StartsWith(Prefix, ESearchCase::CaseSensitive); });
+}
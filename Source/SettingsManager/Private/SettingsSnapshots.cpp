@@ -0,0 +1,241 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsSnapshots.h"
+
+#include "ISettingsCategory.h"
+#include "ISettingsContainer.h"
+#include "ISettingsModule.h"
+#include "ISettingsSection.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/SecureHash.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#define LOCTEXT_NAMESPACE "SettingsSnapshots"
+
+static TAutoConsoleVariable<int32> CVarMaxSnapshots(
+    TEXT("SettingsManager.MaxSnapshots"),
+    50,
+    TEXT("Number of import snapshots kept. The oldest ones are deleted beyond it, and 0 keeps every one."));
+
+namespace
+{
+    const TCHAR* const IndexExtension = TEXT(".txt");
+    const TCHAR* const ObjectsFolderName = TEXT("Objects");
+
+    bool ParseIndexLine(const FString& Line, FString& OutHash, FSettingsSectionKey& OutKey)
+    {
+        FString Path;
+        TArray<FString> Names;
+        if (!Line.Split(TEXT(" "), &OutHash, &Path) || Path.ParseIntoArray(Names, TEXT("/")) != 3)
+        {
+            return false;
+        }
+
+        OutKey = { FName{ *Names[0] }, FName{ *Names[1] }, FName{ *Names[2] } };
+        return true;
+    }
+}
+
+bool FSettingsSnapshots::FBuilder::AddSection(const FSettingsSectionFile& Section)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsSnapshots::AddSection);
+    const double StartTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT{ ElapsedSeconds += FPlatformTime::Seconds() - StartTime; };
+
+    // whatever key filter the import uses, the whole section is kept so that rolling back restores all of it
+    FString Contents;
+    if (!FSettingsManagerOperations::CaptureSection(Section.Section, Section.FilePath, Contents) && Contents.IsEmpty())
+    {
+        return false;
+    }
+    if (Contents.IsEmpty())
+    {
+        return true;
+    }
+
+    const FTCHARToUTF8 Utf8Contents(*Contents);
+    FSHAHash ContentHash;
+    FSHA1::HashBuffer(Utf8Contents.Get(), Utf8Contents.Length(), ContentHash.Hash);
+    FString Hash = ContentHash.ToString();
+
+    // identical contents are stored once, which is what makes snapshotting the same sections over and over nearly free
+    if (!StoredHashes.Contains(Hash))
+    {
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+        const FString ObjectPath = GetObjectPath(Hash);
+        if (!PlatformFile.FileExists(*ObjectPath))
+        {
+            if (!IsStoreCreated)
+            {
+                IsStoreCreated = PlatformFile.CreateDirectoryTree(*FPaths::GetPath(ObjectPath));
+            }
+
+            // written aside and moved in place, so that an interrupted write never leaves a truncated file under a valid hash
+            const FString TempPath = ObjectPath + TEXT(".tmp");
+            if (!IsStoreCreated || !FFileHelper::SaveStringToFile(Contents, *TempPath) || !IFileManager::Get().Move(*ObjectPath, *TempPath))
+            {
+                IFileManager::Get().Delete(*TempPath, false, false, true);
+                return false;
+            }
+            ++NumNewContents;
+        }
+        StoredHashes.Add(Hash);
+    }
+
+    Entries.Emplace(Section.Key.ToString(), MoveTemp(Hash));
+    return true;
+}
+
+FString FSettingsSnapshots::FBuilder::Save()
+{
+    if (Entries.IsEmpty())
+    {
+        return FString();
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsSnapshots::Save);
+    const double StartTime = FPlatformTime::Seconds();
+
+    // named after the time, so that sorting the names sorts the snapshots
+    const FString BaseName = FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S.%s"));
+    FString Name = BaseName;
+    for (int32 Suffix = 2; FPaths::FileExists(GetIndexPath(Name)); ++Suffix)
+    {
+        Name = FString::Printf(TEXT("%s-%d"), *BaseName, Suffix);
+    }
+
+    TStringBuilder<4096> Index;
+    for (const auto& [Path, Hash] : Entries)
+    {
+        Index << Hash << TEXT(' ') << Path << TEXT('\n');
+    }
+
+    if (!FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*GetStoreFolder()) ||
+        !FFileHelper::SaveStringToFile(Index.ToView(), *GetIndexPath(Name)))
+    {
+        UE_LOG(LogSettingsManager, Warning, TEXT("Couldn't write the snapshot '%s'"), *GetIndexPath(Name));
+        return FString();
+    }
+
+    Prune();
+
+    UE_LOG(LogSettingsManager, Log, TEXT("Snapshotted %d sections as '%s' in %.1f ms, storing %d new contents"),
+        Entries.Num(), *Name, (ElapsedSeconds + FPlatformTime::Seconds() - StartTime) * 1000.0, NumNewContents);
+
+    Entries.Reset();
+    NumNewContents = 0;
+    ElapsedSeconds = 0.0;
+    return Name;
+}
+
+TArray<FString> FSettingsSnapshots::GetSnapshotNames()
+{
+    TArray<FString> Names;
+    IFileManager::Get().FindFiles(Names, *FPaths::Combine(GetStoreFolder(), FString(TEXT("*")) + IndexExtension), true, false);
+    for (FString& Name : Names)
+    {
+        Name = FPaths::GetBaseFilename(Name);
+    }
+    Names.Sort(TGreater<FString>());
+    return Names;
+}
+
+bool FSettingsSnapshots::LoadSnapshot(const FString& Name, TArray<FSettingsSectionFile>& OutSections, TArray<FText>& OutFailures)
+{
+    TArray<FString> Lines;
+    if (Name.IsEmpty() || !FFileHelper::LoadFileToStringArray(Lines, *GetIndexPath(Name)))
+    {
+        return false;
+    }
+
+    ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
+    for (const FString& Line : Lines)
+    {
+        FString Hash;
+        FSettingsSectionKey Key;
+        if (!ParseIndexLine(Line, Hash, Key))
+        {
+            continue;
+        }
+
+        const TSharedPtr<ISettingsContainer> Container = SettingsModule != nullptr ? SettingsModule->GetContainer(Key.ContainerName) : nullptr;
+        const TSharedPtr<ISettingsCategory> Category = Container.IsValid() ? Container->GetCategory(Key.CategoryName) : nullptr;
+        const TSharedPtr<ISettingsSection> Section = Category.IsValid() ? Category->GetSection(Key.SectionName) : nullptr;
+        if (Section.IsValid() && Section->CanImport())
+        {
+            OutSections.Add(FSettingsManagerOperations::MakeSectionFile(Container, Category, Section, GetObjectPath(Hash)));
+        }
+        else
+        {
+            OutFailures.Add(FText::Format(LOCTEXT("SectionNotRegistered", "{0} (no longer registered)"), FText::FromString(Key.ToString())));
+        }
+    }
+    return true;
+}
+
+FString FSettingsSnapshots::GetStoreFolder()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SettingsManager"), TEXT("Snapshots"));
+}
+
+FString FSettingsSnapshots::GetObjectPath(const FString& Hash)
+{
+    return FPaths::Combine(GetStoreFolder(), ObjectsFolderName, Hash + TEXT(".ini"));
+}
+
+FString FSettingsSnapshots::GetIndexPath(const FString& Name)
+{
+    return FPaths::Combine(GetStoreFolder(), Name + IndexExtension);
+}
+
+void FSettingsSnapshots::Prune()
+{
+    const int32 MaxSnapshots = CVarMaxSnapshots.GetValueOnGameThread();
+    const TArray<FString> Names = GetSnapshotNames();
+    if (MaxSnapshots <= 0 || Names.Num() <= MaxSnapshots)
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(FSettingsSnapshots::Prune);
+
+    for (int32 Index = MaxSnapshots; Index < Names.Num(); ++Index)
+    {
+        IFileManager::Get().Delete(*GetIndexPath(Names[Index]), false, false, true);
+    }
+
+    // contents are shared by snapshots, so only the ones none of the remaining snapshots refer to can go
+    TSet<FString> ReferencedHashes;
+    for (int32 Index = 0; Index < MaxSnapshots; ++Index)
+    {
+        TArray<FString> Lines;
+        FFileHelper::LoadFileToStringArray(Lines, *GetIndexPath(Names[Index]));
+        for (const FString& Line : Lines)
+        {
+            FString Hash;
+            FSettingsSectionKey Key;
+            if (ParseIndexLine(Line, Hash, Key))
+            {
+                ReferencedHashes.Add(MoveTemp(Hash));
+            }
+        }
+    }
+
+    const FString ObjectsFolder = FPaths::Combine(GetStoreFolder(), ObjectsFolderName);
+    TArray<FString> ObjectNames;
+    IFileManager::Get().FindFiles(ObjectNames, *FPaths::Combine(ObjectsFolder, TEXT("*.ini")), true, false);
+    for (const FString& ObjectName : ObjectNames)
+    {
+        if (!ReferencedHashes.Contains(FPaths::GetBaseFilename(ObjectName)))
+        {
+            IFileManager::Get().Delete(*FPaths::Combine(ObjectsFolder, ObjectName), false, false, true);
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,262 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SettingsManagerBenchmarkSettings.h"
+
+#include "ISettingsModule.h"
+#include "SettingsManagerLibrary.h"
+#include "SettingsManagerOperations.h"
+#include "SettingsManagerWindow.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Input/HittestGrid.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Rendering/DrawElements.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "Widgets/SVirtualWindow.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    const FName BenchmarkContainerName = TEXT("Editor");
+    const FName BenchmarkCategoryName = TEXT("SettingsManagerBenchmark");
+
+    /** Registers synthetic sections with the settings module for as long as it lives. */
+    class FSyntheticSections
+    {
+    public:
+        explicit FSyntheticSections(int32 NumSections)
+        {
+            ISettingsModule& SettingsModule = FModuleManager::LoadModuleChecked<ISettingsModule>("Settings");
+
+            Objects.Reserve(NumSections);
+            for (int32 Index = 0; Index < NumSections; ++Index)
+            {
+                const FName SectionName = *FString::Printf(TEXT("Section%05d"), Index);
+                USettingsManagerBenchmarkSettings* Settings = NewObject<USettingsManagerBenchmarkSettings>(GetTransientPackage(),
+                    *FString::Printf(TEXT("SettingsManagerBenchmark_%05d"), Index));
+                Settings->AddToRoot();
+                Objects.Add(Settings);
+                Randomize(Index);
+
+                SettingsModule.RegisterSettings(BenchmarkContainerName, BenchmarkCategoryName, SectionName,
+                    FText::FromName(SectionName), FText::GetEmpty(), Settings);
+                SectionNames.Add(SectionName);
+            }
+        }
+
+        ~FSyntheticSections()
+        {
+            ISettingsModule& SettingsModule = FModuleManager::LoadModuleChecked<ISettingsModule>("Settings");
+            for (const FName& SectionName : SectionNames)
+            {
+                SettingsModule.UnregisterSettings(BenchmarkContainerName, BenchmarkCategoryName, SectionName);
+            }
+
+            for (USettingsManagerBenchmarkSettings* Settings : Objects)
+            {
+                Settings->RemoveFromRoot();
+            }
+
+            const FString ConfigFile = USettingsManagerBenchmarkSettings::StaticClass()->GetConfigName();
+            GConfig->Remove(ConfigFile);
+            IFileManager::Get().Delete(*ConfigFile, false, false, true);
+        }
+
+        /** Changes every value, so that importing back what was exported before changes every section. */
+        void RandomizeAll()
+        {
+            for (int32 Index = 0; Index < Objects.Num(); ++Index)
+            {
+                Randomize(Index);
+            }
+        }
+
+    private:
+        void Randomize(int32 Index)
+        {
+            USettingsManagerBenchmarkSettings* Settings = Objects[Index];
+            Settings->IntValue = FMath::Rand();
+            Settings->FloatValue = FMath::FRand();
+            Settings->StringValue = FString::Printf(TEXT("Value %d of section %d"), FMath::Rand(), Index);
+            Settings->ArrayValue = { FString::FromInt(FMath::Rand()), FString::FromInt(FMath::Rand()), FString::FromInt(FMath::Rand()) };
+        }
+
+    private:
+        TArray<USettingsManagerBenchmarkSettings*> Objects;
+        TArray<FName> SectionNames;
+    };
+
+    /**
+     * Lays out, ticks and paints a widget in a window of its own the way every frame of the editor does, only into an element list that
+     * nothing draws, so that it runs without a renderer. Painting is what ticks the widgets and therefore generates the rows of tree views.
+     */
+    class FOffscreenWindow
+    {
+    public:
+        FOffscreenWindow(const TSharedRef<SWidget>& Content, FVector2D InSize)
+            : Size(InSize)
+            , Window(SNew(SVirtualWindow).Size(InSize))
+            , ElementList(Window)
+        {
+            Window->SetContent(Content);
+        }
+
+        void DrawFrame(float DeltaTime)
+        {
+            const FGeometry WindowGeometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+            Window->SlatePrepass(1.f);
+
+            ElementList.ResetElementList();
+            Window->GetHittestGrid().SetHittestArea(FVector2D::ZeroVector, Size);
+            const FPaintArgs PaintArgs(nullptr, Window->GetHittestGrid(), FVector2D::ZeroVector, FApp::GetCurrentTime(), DeltaTime);
+            Window->Paint(PaintArgs, WindowGeometry, FSlateRect(FVector2D::ZeroVector, Size), ElementList, 0, FWidgetStyle(), true);
+        }
+
+    private:
+        FVector2D Size;
+        TSharedRef<SVirtualWindow> Window;
+        FSlateWindowElementList ElementList;
+    };
+
+    template<typename FunctionType>
+    double MeasureMilliseconds(FunctionType&& Function)
+    {
+        const double StartTime = FPlatformTime::Seconds();
+        Function();
+        return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    }
+}
+
+/**
+ * Measures the window and the bulk operations against 10 to 5000 synthetic sections, and writes the results to Saved/Automation/SettingsManagerBenchmark.
+ * Runs headless, e.g. UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests Plugins.SettingsManager.Benchmark; Quit"
+ * Another number of sections can be measured with -SettingsManagerBenchmarkSections=<N>.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FSettingsManagerBenchmark, "Plugins.SettingsManager.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FSettingsManagerBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    TArray<int32> SectionCounts = { 10, 100, 1000, 5000 };
+    if (int32 NumSections = 0;
+        FParse::Value(FCommandLine::Get(), TEXT("SettingsManagerBenchmarkSections="), NumSections) && NumSections > 0)
+    {
+        SectionCounts.AddUnique(NumSections);
+    }
+
+    for (const int32 NumSections : SectionCounts)
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("%d Sections"), NumSections));
+        OutTestCommands.Add(FString::FromInt(NumSections));
+    }
+}
+
+bool FSettingsManagerBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 NumSections = FCString::Atoi(*Parameters);
+    if (!TestTrue(TEXT("Number of sections"), NumSections > 0))
+    {
+        return false;
+    }
+
+    constexpr int32 NumIdleFrames = 60;
+    const FString Folder = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("SettingsManagerBenchmark"), Parameters);
+    const FString Include = BenchmarkCategoryName.ToString();
+
+    FSyntheticSections Sections{ NumSections };
+
+    // the window only builds the tab it shows, which is the Editor one with the synthetic sections
+    TSharedPtr<SSettingsManagerWindow> Window;
+    const double ConstructMs = MeasureMilliseconds([&Window]()
+        {
+            Window = SNew(SSettingsManagerWindow, true, nullptr);
+        });
+
+    // the first frame generates the rows in view, and the following ones poll their attributes while nothing changes
+    TOptional<FOffscreenWindow> OffscreenWindow{ InPlace, Window.ToSharedRef(), FVector2D(1280.0, 1600.0) };
+    const double FirstFrameMs = MeasureMilliseconds([&OffscreenWindow]()
+        {
+            OffscreenWindow->DrawFrame(0.f);
+        });
+    const double IdleFrameMs = MeasureMilliseconds([&OffscreenWindow]()
+        {
+            for (int32 Frame = 0; Frame < NumIdleFrames; ++Frame)
+            {
+                OffscreenWindow->DrawFrame(1.f / 60.f);
+            }
+        }) / NumIdleFrames;
+    OffscreenWindow.Reset();
+    Window.Reset();
+
+    FSettingsManagerResult ExportResult;
+    const double ExportMs = MeasureMilliseconds([&ExportResult, &Folder, &Include]()
+        {
+            ExportResult = USettingsManagerLibrary::ExportSettings(Folder, BenchmarkContainerName.ToString(), FString(), Include);
+        });
+    TestEqual(TEXT("Export failures"), ExportResult.NumFailed, 0);
+
+    FSettingsImportData ImportData;
+    const double ScanMs = MeasureMilliseconds([&ImportData, &Folder]()
+        {
+            ImportData = FSettingsManagerOperations::ScanImportDirectory(Folder);
+        });
+    TestEqual(TEXT("Scanned sections"), ImportData.Files.FindRef(BenchmarkCategoryName).Num(), NumSections);
+
+    Sections.RandomizeAll();
+
+    // snapshotting would add to the import time, and write to and prune the user's own snapshots, so it's off for the benchmark
+    IConsoleVariable* SnapshotBeforeImport = IConsoleManager::Get().FindConsoleVariable(TEXT("SettingsManager.SnapshotBeforeImport"));
+    const bool WasSnapshotting = SnapshotBeforeImport != nullptr && SnapshotBeforeImport->GetBool();
+    if (SnapshotBeforeImport != nullptr)
+    {
+        SnapshotBeforeImport->Set(false, ECVF_SetByCode);
+    }
+    ON_SCOPE_EXIT
+    {
+        if (SnapshotBeforeImport != nullptr)
+        {
+            SnapshotBeforeImport->Set(WasSnapshotting, ECVF_SetByCode);
+        }
+    };
+
+    FSettingsManagerResult ImportResult;
+    const double ImportMs = MeasureMilliseconds([&ImportResult, &Folder, &Include]()
+        {
+            ImportResult = USettingsManagerLibrary::ImportSettings(Folder, BenchmarkContainerName.ToString(), FString(), Include);
+        });
+    TestEqual(TEXT("Import failures"), ImportResult.NumFailed, 0);
+
+    IFileManager::Get().DeleteDirectory(*Folder, false, true);
+
+    const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("NumSections"), NumSections);
+    Json->SetNumberField(TEXT("ConstructMs"), ConstructMs);
+    Json->SetNumberField(TEXT("FirstFrameMs"), FirstFrameMs);
+    Json->SetNumberField(TEXT("IdleFrameMs"), IdleFrameMs);
+    Json->SetNumberField(TEXT("ExportMs"), ExportMs);
+    Json->SetNumberField(TEXT("ScanMs"), ScanMs);
+    Json->SetNumberField(TEXT("ImportMs"), ImportMs);
+    Json->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+    Json->SetStringField(TEXT("Date"), FDateTime::UtcNow().ToIso8601());
+
+    FString JsonString;
+    FJsonSerializer::Serialize(Json, TJsonWriterFactory<>::Create(&JsonString));
+    AddInfo(JsonString);
+
+    const FString ReportPath = FPaths::Combine(FPaths::AutomationDir(), TEXT("SettingsManagerBenchmark"), Parameters + TEXT(".json"));
+    TestTrue(TEXT("Results written"), FFileHelper::SaveStringToFile(JsonString, *ReportPath));
+
+    return true;
+}
+
+#endif
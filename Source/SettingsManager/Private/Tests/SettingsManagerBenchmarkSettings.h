@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "SettingsManagerBenchmarkSettings.generated.h"
+
+/**
+ * Settings object behind the synthetic sections registered by the benchmark. Each section gets its own instance, and therefore its own ini section.
+ */
+UCLASS(config = SettingsManagerBenchmark, perObjectConfig)
+class USettingsManagerBenchmarkSettings
+	: public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(config)
+	int32 IntValue = 0;
+
+	UPROPERTY(config)
+	float FloatValue = 0.f;
+
+	UPROPERTY(config)
+	FString StringValue;
+
+	UPROPERTY(config)
+	TArray<FString> ArrayValue;
+};
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SettingsManagerOperations.h"
+
+/**
+ * Single-file alternative to the Category/Section.ini folder layout.
+ * A header and a table of contents of every section, followed by the sections' ini text as UTF-8 blobs that are optionally zlib-compressed.
+ */
+class FSettingsArchive
+{
+public:
+	static const TCHAR* const Extension;
+
+	/** Packs the sections into a single file. Can be called from any thread. */
+	static bool Write(const FString& ArchivePath, const TArray<FCapturedSettingsSection>& Sections, bool Compress);
+
+	/** Reads the whole archive with a single file open, and indexes its table of contents. Returns null if the file isn't a valid archive. */
+	static TSharedPtr<FSettingsArchive> Open(const FString& ArchivePath);
+
+public:
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Every section in the archive, in the order they were written. */
+	const TArray<FSettingsSectionKey>& GetKeys() const { return Keys; }
+
+	bool ReadSection(const FSettingsSectionKey& Key, FString& OutContents) const;
+
+private:
+	struct FTocEntry
+	{
+		int64 Offset = 0;
+		int32 StoredSize = 0;
+		int32 RawSize = 0;
+	};
+
+	FString FilePath;
+	bool IsCompressed = false;
+	TArray<FSettingsSectionKey> Keys;
+	TMap<FSettingsSectionKey, FTocEntry> Toc;
+	/** The whole file. The blobs start right after the table of contents. */
+	TArray<uint8> Data;
+	int64 BlobsOffset = 0;
+};
@@ -20,6 +20,7 @@ public:
 	/** This function will be bound to Command (by default it will bring up plugin window) */
 	void ExportButtonClicked();
 	void ImportButtonClicked();
+	void ImportArchiveButtonClicked();
 
 private:
 	void RegisterMenus();
@@ -29,6 +30,10 @@ private:
 
 
 private:
-	SSettingsManagerWindow::FImportData ImportData;
+	/** What the import tab imports from, kept to reopen the same source without scanning it again. */
+	TSharedPtr<const FSettingsImportData> ImportManifest;
+	bool IsScanningImportSource = false;
+	/** Only referenced weakly by the asynchronous work calling back into the module, which does nothing once it's shut down. */
+	TSharedPtr<bool> AliveToken;
 	TSharedPtr<class FUICommandList> PluginCommands;
 };
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SettingsManagerCommandlet.generated.h"
+
+/**
+ * Bulk exports or imports settings without the UI, going through the same sections the Bulk Export/Import Settings windows list.
+ * Also rolls imports back to the snapshots taken before them.
+ *
+ * -run=SettingsManager -Mode=<Export|Import> <-Dir=<Folder>|-Archive=<File>> [-Incremental] [-Container=<Editor|Project|All>] [-Preset=<Name>]
+ *     [-Include=<Patterns>] [-Exclude=<Patterns>] [-IncludeKeys=<Patterns>] [-ExcludeKeys=<Patterns>] [-Merge]
+ * -run=SettingsManager -Mode=Rollback [-Snapshot=<Name>]
+ *
+ * Patterns are comma-separated wildcards over "Category/Section" names, e.g. -Include=LevelEditor/*,ContentBrowser
+ * Key patterns are wildcards over config key names, e.g. -IncludeKeys=*DerivedDataCache*
+ */
+UCLASS()
+class USettingsManagerCommandlet
+	: public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USettingsManagerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -21,4 +21,5 @@ public:
 public:
 	TSharedPtr< FUICommandInfo > OpenExportWindow;
 	TSharedPtr< FUICommandInfo > OpenImportWindow;
+	TSharedPtr< FUICommandInfo > OpenImportArchiveWindow;
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "SettingsManagerLibrary.generated.h"
+
+UENUM(BlueprintType)
+enum class ESettingsManagerSectionStatus : uint8
+{
+	Succeeded,
+	/** Left alone because it wouldn't have changed anything. */
+	Unchanged,
+	Failed,
+};
+
+USTRUCT(BlueprintType)
+struct FSettingsManagerSectionResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	FName Container;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	FName Category;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	FName Section;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	ESettingsManagerSectionStatus Status = ESettingsManagerSectionStatus::Failed;
+
+	/** Time spent on this section alone, excluding work shared by several sections such as batched config writes. */
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	double ElapsedMilliseconds = 0.0;
+
+	/** Size of the file written on export, or of the ini text read on import. Unknown for packed archive entries on export. */
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	int64 NumBytes = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FSettingsManagerResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	TArray<FSettingsManagerSectionResult> Sections;
+
+	/** Number of failed sections, plus one for a run that couldn't start at all, e.g. because of an unknown container. */
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	int32 NumFailed = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	TArray<FString> Errors;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Settings Manager")
+	double ElapsedMilliseconds = 0.0;
+};
+
+/**
+ * Bulk export/import for scripts, e.g. from Python as unreal.SettingsManagerLibrary.export_settings("D:/Settings", preset="Team").
+ * Also available as the SettingsManager.Export, SettingsManager.Import and SettingsManager.Rollback console commands, and used by the
+ * SettingsManager commandlet.
+ *
+ * Path is a folder laid out as Category/Section.ini, or a single settings archive if it ends with .uesettings.
+ * Container "All" handles every container in one run, laid out as Container/Category/Section.ini in a folder.
+ * Include and Exclude are comma-separated wildcards over "Category/Section" names. A pattern without '/' matches a whole category.
+ * IncludeKeys and ExcludeKeys are comma-separated wildcards over config key names, or over "IniSection:Key" for patterns with a ':'.
+ * They restrict the sections to the matching keys, and the other keys are neither written nor imported.
+ * Merge imports three-way merge each key with its engine default and local value instead of overwriting the sections, see ESettingsImportMode.
+ */
+UCLASS()
+class USettingsManagerLibrary
+	: public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "Settings Manager")
+	static FSettingsManagerResult ExportSettings(const FString& Path, const FString& Container = TEXT("Editor"), const FString& Preset = TEXT(""),
+		const FString& Include = TEXT(""), const FString& Exclude = TEXT(""), bool Incremental = false, const FString& IncludeKeys = TEXT(""),
+		const FString& ExcludeKeys = TEXT(""));
+
+	UFUNCTION(BlueprintCallable, Category = "Settings Manager")
+	static FSettingsManagerResult ImportSettings(const FString& Path, const FString& Container = TEXT("Editor"), const FString& Preset = TEXT(""),
+		const FString& Include = TEXT(""), const FString& Exclude = TEXT(""), const FString& IncludeKeys = TEXT(""), const FString& ExcludeKeys = TEXT(""),
+		bool Merge = false);
+
+	/**
+	 * Restores the sections snapshotted right before an import, from the newest snapshot if none is given.
+	 * The rollback is an import too, so it's snapshotted in turn and can itself be rolled back.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Settings Manager")
+	static FSettingsManagerResult RollbackSettings(const FString& Snapshot = TEXT(""));
+
+	/** Names of the snapshots taken before imports, newest first. */
+	UFUNCTION(BlueprintCallable, Category = "Settings Manager")
+	static TArray<FString> GetSnapshots();
+
+	/** Logs the failures and a summary of the run. */
+	static void LogResult(const FString& Operation, const FString& Container, const FSettingsManagerResult& Result);
+
+	/** Container name standing for every container. */
+	static const TCHAR* const AllContainers;
+};
@@ -0,0 +1,379 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+class ISettingsCategory;
+class ISettingsContainer;
+class ISettingsSection;
+class FSettingsArchive;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSettingsManager, Log, All);
+
+/**
+ * Identifies a section across containers.
+ */
+struct FSettingsSectionKey
+{
+	FName ContainerName;
+	FName CategoryName;
+	FName SectionName;
+
+	/** "Container/Category/Section" */
+	FString ToString() const;
+
+	bool operator==(const FSettingsSectionKey& Other) const
+	{
+		return ContainerName == Other.ContainerName && CategoryName == Other.CategoryName && SectionName == Other.SectionName;
+	}
+
+	friend uint32 GetTypeHash(const FSettingsSectionKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.ContainerName), GetTypeHash(Key.CategoryName)), GetTypeHash(Key.SectionName));
+	}
+};
+
+/**
+ * A section's config state, captured on the game thread so it can be written from any thread.
+ */
+struct FCapturedSettingsSection
+{
+	FSettingsSectionKey Key;
+	/** "Category/Section", used when reporting failures. */
+	FText DisplayName;
+	FString FilePath;
+	FString Contents;
+	double CaptureSeconds = 0.0;
+};
+
+/** What a folder or archive file looked like on disk, compared to tell whether it changed since it was read. */
+struct FSettingsSourceStamp
+{
+	FDateTime NewestTimeStamp;
+	int64 TotalSize = 0;
+	int32 NumFiles = 0;
+
+	bool operator==(const FSettingsSourceStamp& Other) const = default;
+};
+
+/**
+ * Where the sections to import come from: either Category/Section.ini files of a folder, or a packed archive.
+ * A folder holding a combined export of several containers has one subfolder per container instead, each scanned into its own import data.
+ */
+struct FSettingsImportData
+{
+	/** Category name -> section name -> path of the .ini file to import the section from. */
+	TMap<FName, TMap<FName, FString>> Files;
+	/** Set when importing from a packed archive, in which case Files is unused. */
+	TSharedPtr<FSettingsArchive> Archive;
+	/** .ini files of the folder that couldn't be read or parsed, and were therefore left out of Files. */
+	TArray<FString> InvalidFiles;
+	/** The folder or archive file the data was read from. */
+	FString Source;
+	/** Stamp of Source taken before reading it, to reuse the data only as long as Source is unchanged. */
+	FSettingsSourceStamp SourceStamp;
+	/** Set when the folder is a combined export, in which case Files is unused. Container name -> import data of its subfolder. */
+	TMap<FName, TSharedPtr<const FSettingsImportData>> Containers;
+};
+
+/** Import data shared by the module and the windows importing from it. It's never modified once scanned, so it can be reused instead of copied. */
+using FSettingsImportManifest = TSharedRef<const FSettingsImportData>;
+
+/**
+ * Wildcard include/exclude patterns over "Category/Section" internal names. A pattern without a '/' matches a whole category.
+ * An empty include list includes everything.
+ */
+struct FSettingsSectionFilter
+{
+	TArray<FString> Include;
+	TArray<FString> Exclude;
+
+	/** Parses comma-separated pattern lists, as given on a command line. */
+	static FSettingsSectionFilter Parse(const FString& IncludeList, const FString& ExcludeList);
+
+	bool Matches(FName CategoryName, FName SectionName) const;
+};
+
+/**
+ * Wildcard include/exclude patterns over config key names, compiled once and then matched against every key streamed in or out of a section.
+ * A pattern with a ':' is matched against "IniSection:Key" instead of the key alone. An empty include list includes everything.
+ */
+class FSettingsKeyFilter
+{
+public:
+	/** Compiles comma-separated pattern lists, as given on a command line. Null if both are empty, since such a filter would keep every key. */
+	static TSharedPtr<const FSettingsKeyFilter> Parse(const FString& IncludeList, const FString& ExcludeList);
+
+	bool Matches(const FString& IniSectionName, FName Key) const;
+
+	/** Keeps the lines of ini text whose key matches, and the headers of the ini sections left with at least one of them. */
+	FString FilterContents(const FString& Contents) const;
+
+private:
+	struct FPatterns
+	{
+		/** Patterns without wildcards, looked up instead of matched. */
+		TSet<FName> Keys;
+		TSet<FString> QualifiedKeys;
+		TArray<FString> KeyWildcards;
+		TArray<FString> QualifiedWildcards;
+
+		void Add(const FString& Pattern);
+		bool IsEmpty() const;
+		bool Matches(const FString& IniSectionName, FName Key) const;
+	};
+
+	FPatterns Include;
+	FPatterns Exclude;
+};
+
+/**
+ * The sections of a category picked for export or import, in the order they are listed.
+ */
+struct FSettingsCategorySections
+{
+	TSharedPtr<ISettingsCategory> Category;
+	TArray<TSharedPtr<ISettingsSection>> Sections;
+	/** Import only, parallel to Sections. */
+	TArray<FString> FilePaths;
+};
+
+/**
+ * A section and the file it's exported to or imported from.
+ */
+struct FSettingsSectionFile
+{
+	TSharedPtr<ISettingsSection> Section;
+	FSettingsSectionKey Key;
+	FString FilePath;
+	/** "Category/Section", used when reporting failures. */
+	FText DisplayName;
+	/** If set, only the matching keys are exported or imported, and the others are left as they are. */
+	TSharedPtr<const FSettingsKeyFilter> KeyFilter;
+};
+
+/**
+ * A config key of the ini text a section would be imported from, whose value differs from the section's live state.
+ * The values of array keys are joined with line breaks, and a missing current value means the key isn't set locally.
+ */
+struct FSettingsKeyDiff
+{
+	FString IniSectionName;
+	FName Key;
+	TOptional<FString> CurrentValue;
+	FString IncomingValue;
+};
+
+enum class ESettingsSectionStatus : uint8
+{
+	Succeeded,
+	/** Left alone because it wouldn't have changed anything. */
+	Unchanged,
+	Failed,
+};
+
+enum class ESettingsImportMode : uint8
+{
+	/** The imported sections replace the live ones. */
+	Overwrite,
+	/**
+	 * Each key is three-way merged, with the engine and project defaults as the base, the live state as the local side and the imported file as the
+	 * other one, and only the keys that change are loaded and saved.
+	 */
+	Merge,
+};
+
+/** What happened to one section of a bulk export or import. */
+struct FSettingsSectionResult
+{
+	FSettingsSectionKey Key;
+	ESettingsSectionStatus Status = ESettingsSectionStatus::Failed;
+	/** Time spent on this section alone, excluding work shared by several sections such as batched config writes. */
+	double ElapsedSeconds = 0.0;
+	/** Size of the file written on export, or of the ini text read on import. Unknown for packed archive entries on export. */
+	int64 NumBytes = 0;
+};
+
+struct FSettingsImportStats
+{
+	int32 NumSectionsImported = 0;
+	/** Sections left alone because importing them wouldn't change any key. */
+	int32 NumSectionsUnchanged = 0;
+	/** Number of config files written to the disk while saving the imported sections. */
+	int32 NumFilesWritten = 0;
+	/** Merge only: keys changed both locally and by the imported file, resolved as set by SettingsManager.MergeConflicts and logged one by one. */
+	int32 NumConflicts = 0;
+	/** The snapshot of the imported sections as they were before, empty if none was taken. */
+	FString SnapshotName;
+	double ElapsedSeconds = 0.0;
+	/** Parallel to the imported sections. */
+	TArray<FSettingsSectionResult> SectionResults;
+};
+
+/**
+ * Export/import building blocks that don't depend on the UI.
+ */
+class FSettingsManagerOperations
+{
+public:
+	/** Every category of the container with its exportable sections, in the order set by SettingsManager.SectionOrder. */
+	static TArray<FSettingsCategorySections> GetExportableSections(const TSharedPtr<ISettingsContainer>& Container, const FSettingsSectionFilter& Filter = {});
+
+	/** The exportable sections of one category, in the order set by SettingsManager.SectionOrder. */
+	static FSettingsCategorySections GetExportableSections(const TSharedPtr<ISettingsCategory>& Category, const FSettingsSectionFilter& Filter = {});
+
+	/**
+	 * Every category of the import data that exists in the container, with the sections that exist and can be imported.
+	 * Entries of a packed archive must also have been exported from the container, and only the container's subfolder of a combined export is used.
+	 */
+	static TArray<FSettingsCategorySections> GetImportableSections(const TSharedPtr<ISettingsContainer>& Container, const FSettingsImportData& ImportData,
+		const FSettingsSectionFilter& Filter = {});
+
+	/** Every container registered with the settings module: Editor, Project, then the others by name. */
+	static TArray<TSharedPtr<ISettingsContainer>> GetContainers();
+
+	/** Where a combined export puts the sections of a container. */
+	static FString GetContainerFolder(const FString& Root, FName ContainerName);
+
+	/** Marks a folder as a combined export of the containers, so that scanning it looks into their subfolders. */
+	static bool WriteContainersFile(const FString& Root, const TArray<FName>& ContainerNames);
+
+	/** Name of the file listing the containers of a combined export, one per line, at its root. */
+	static const TCHAR* const ContainersFileName;
+
+	/**
+	 * Finds the Category/Section.ini files of an export folder, reading and parsing them in parallel to leave out the invalid ones.
+	 * The subfolders of a combined export are scanned together.
+	 */
+	static FSettingsImportData ScanImportDirectory(const FString& Folder);
+
+	/**
+	 * Scans the folder on a worker thread, stamping it first. OnScanned is called on the game thread.
+	 * A previous scan of the same folder is passed back as is instead if the folder is unchanged since.
+	 */
+	static void ScanImportDirectoryAsync(const FString& Folder, TSharedPtr<const FSettingsImportData> PreviousScan,
+		TUniqueFunction<void(const FSettingsImportManifest&)> OnScanned);
+
+	/** Stamps an archive file, or every file under a folder. Only the file system metadata is read, which is much cheaper than scanning. */
+	static FSettingsSourceStamp GetSourceStamp(const FString& Source);
+
+	static FString GetSectionFilePath(const FString& Folder, FName CategoryName, FName SectionName);
+
+	static FSettingsSectionFile MakeSectionFile(const TSharedPtr<ISettingsContainer>& Container, const TSharedPtr<ISettingsCategory>& Category,
+		const TSharedPtr<ISettingsSection>& Section, const FString& FilePath);
+
+	/**
+	 * Serializes the config state of a section the same way ISettingsSection::Export would write it to FileName, without touching the disk when possible.
+	 * Must be called on the game thread. OutContents may be filled even if this returns false, since some sections report a failure after exporting fine.
+	 * If a key filter is given, only the matching keys are written.
+	 */
+	static bool CaptureSection(const TSharedPtr<ISettingsSection>& Section, const FString& FileName, FString& OutContents,
+		const FSettingsKeyFilter* KeyFilter = nullptr);
+
+	/**
+	 * Captures every section for its file, skipping the ones that produced nothing, e.g. because none of their keys matched their key filter.
+	 * The keys of the sections that failed are added to OutFailedKeys if given. Must be called on the game thread.
+	 */
+	static TArray<FCapturedSettingsSection> CaptureSections(const TArray<FSettingsSectionFile>& Sections, TArray<FText>& OutFailures,
+		TSet<FSettingsSectionKey>* OutFailedKeys = nullptr);
+
+	/** Reads the ini text a section would be imported from, either its file or its entry in the archive, keeping only the keys of its key filter. */
+	static bool ReadSectionContents(const FSettingsSectionFile& Section, const FSettingsArchive* Archive, FString& OutContents);
+
+	/**
+	 * Compares the keys of the section's live state with the ini text it would be imported from. Must be called on the game thread.
+	 * Returns false if the live state couldn't be captured, in which case the differences are unknown.
+	 * Only the keys of the section's key filter are compared, so IncomingContents must already be filtered, as ReadSectionContents does.
+	 * Keys missing from IncomingContents aren't differences, since importing never unsets them.
+	 */
+	static bool DiffSection(const FSettingsSectionFile& Section, const FString& IncomingContents, TArray<FSettingsKeyDiff>& OutDiffs);
+
+	/**
+	 * Imports a section from ini text that isn't on the disk, e.g. a packed archive entry. VirtualFileName only names the text in GConfig while
+	 * it's being loaded, and must not be the name of a real config file.
+	 */
+	static bool ImportSectionContents(const TSharedPtr<ISettingsSection>& Section, const FString& Contents, const FString& VirtualFileName);
+
+	/**
+	 * Imports and saves the sections. Unless SettingsManager.BatchedImport is off, every section is imported first and saved with config flushing
+	 * suppressed, and each config file dirtied that way is written once at the end instead of once per section.
+	 * If an archive is given, the sections are read from its entries instead of their files.
+	 * Unless SettingsManager.SkipUnchangedSections is off, the sections whose keys wouldn't change are neither imported nor saved.
+	 * Sections with a key filter are imported from their filtered ini text, which leaves the properties of the other keys untouched.
+	 * When merging, the sections without a config object can't be diffed against their defaults, and are imported whole.
+	 * Unless SettingsManager.SnapshotBeforeImport is off, every section is snapshotted right before it's imported.
+	 */
+	static FSettingsImportStats ImportSections(const TArray<FSettingsSectionFile>& Sections, TArray<FText>& OutFailures,
+		const FSettingsArchive* Archive = nullptr, ESettingsImportMode Mode = ESettingsImportMode::Overwrite);
+
+	/**
+	 * Logs the throughput of a bulk export or import and its slowest section.
+	 * If SettingsManager.ReportFolder is set, also writes a CSV report of every section there.
+	 */
+	static void ReportResults(const TCHAR* Operation, const TArray<FSettingsSectionResult>& Results, int64 NumBytes, double ElapsedSeconds);
+};
+
+/**
+ * Writes captured sections to disk on a worker thread. Progress can be polled and cancellation requested from the game thread.
+ */
+class FSettingsExportTask
+	: public TSharedFromThis<FSettingsExportTask>
+{
+public:
+	DECLARE_DELEGATE_OneParam(FOnFinished, const FSettingsExportTask&);
+
+public:
+	/** If an archive path is given, the sections are packed into that single archive instead of being written to their own files. */
+	explicit FSettingsExportTask(TArray<FCapturedSettingsSection>&& InSections, FString InArchivePath = FString());
+
+	/** OnFinished is called on the game thread once every section is written or the task is cancelled. */
+	void Start(FOnFinished InOnFinished);
+
+	void Cancel() { IsCancelRequested = true; }
+	bool IsCancelled() const { return IsCancelRequested; }
+
+	int32 GetNumProcessed() const { return NumProcessed; }
+	int32 GetNumTotal() const { return Sections.Num(); }
+
+	/** Only valid once finished. */
+	const TArray<FText>& GetFailures() const { return Failures; }
+
+	/** Parallel to the captured sections, including the time it took to capture them. Only valid once finished. */
+	const TArray<FSettingsSectionResult>& GetSectionResults() const { return SectionResults; }
+
+	/**
+	 * Only rewrites the files whose contents changed since the last export to Folder, according to the content hashes of a manifest kept there.
+	 * Must be called before the task is started, and has no effect when packing into an archive.
+	 */
+	void SetIncremental(const FString& Folder) { ManifestFolder = Folder; }
+
+	/** Number of sections left untouched because they didn't change. Only valid once finished. */
+	int32 GetNumUnchanged() const { return NumUnchanged; }
+
+	/** Total size of the files written, including an archive or a manifest. Only valid once finished. */
+	int64 GetNumBytesWritten() const { return NumBytesWritten; }
+
+	/** Writes every section on the calling thread. */
+	void Run();
+
+	/** Name of the manifest file kept at the root of an incremental export. */
+	static const TCHAR* const ManifestFileName;
+
+private:
+	void RunIncremental();
+
+private:
+	TArray<FCapturedSettingsSection> Sections;
+	FString ArchivePath;
+	FString ManifestFolder;
+	TArray<FText> Failures;
+	TArray<FSettingsSectionResult> SectionResults;
+	int32 NumUnchanged = 0;
+	int64 NumBytesWritten = 0;
+
+	std::atomic<int32> NumProcessed = 0;
+	std::atomic<bool> IsCancelRequested = false;
+};
@@ -3,10 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SettingsManagerOperations.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Layout/SBox.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/Views/STreeView.h"
 
 class ISettingsContainer;
+class ISettingsSection;
 /**
  * 
  */
@@ -14,50 +18,177 @@ class SSettingsManagerWindow
 	: public SCompoundWidget
 {
 public:
-	struct FSectionDataForExport
+	/** Number of checked sections out of all sections, kept up to date instead of being recounted on every poll. */
+	struct FSelectionCounts
 	{
-		FText DisplayName;
-		ECheckBoxState CheckBoxState;
+		int32 NumChecked = 0;
+		int32 NumTotal = 0;
+		/** Checked sections that are saved at the level opposite to the tab they're listed in. */
+		int32 NumCheckedAtReverseLevel = 0;
+
+		int32 GetNumUnchecked() const { return NumTotal - NumChecked; }
+		ECheckBoxState GetCheckBoxState() const;
 	};
 
-	struct FCategoryDataForExport
+	/**
+	 * A tab's categories and sections, stored flat in tree order. The sections of a category are a contiguous range of the per-section arrays,
+	 * which are parallel to each other, and check states are bits so that whole ranges can be set at once.
+	 */
+	struct FSectionTable
 	{
-		FText DisplayName;
-		TMap<FName, FSectionDataForExport> Sections;
+		struct FCategory
+		{
+			FName Name;
+			FText DisplayName;
+			int32 FirstSection = 0;
+			int32 NumSections = 0;
+			/** Sections of the category saved at the level opposite to the tab, whether they're checked or not. */
+			int32 NumAtReverseLevel = 0;
+			FSelectionCounts SelectionCounts;
+		};
+
+		TArray<FCategory> Categories;
+
+		TArray<FName> SectionNames;
+		TArray<FText> SectionDisplayNames;
+		/** Index of the category of each section. */
+		TArray<int32> SectionCategories;
+		/** Import only. */
+		TArray<FString> SectionFilePaths;
+		/** Import only. The keys importing each section would change, unset until the differences are computed and after importing or modifying the section. */
+		TArray<TOptional<TArray<FSettingsKeyDiff>>> SectionDifferences;
+
+		TBitArray<> CheckedSections;
+		/** Sections saved at the level opposite to the tab, cached until their category is modified. */
+		TBitArray<> ReverseLevelSections;
+
+		/**
+		 * Indices of the General/Appearance and General/InputBindings sections when they export through a custom exporter,
+		 * whose result is reported as failed even when it succeeds.
+		 */
+		int32 AppearanceSection = INDEX_NONE;
+		int32 InputBindingsSection = INDEX_NONE;
+
+		int32 Num() const { return SectionNames.Num(); }
+		int32 FindCategory(FName CategoryName) const;
+		int32 FindSection(FName CategoryName, FName SectionName) const;
+		/** Looks up the sections with false positive failures again, once the rows moved. */
+		void FindFalsePositiveSections(const TSharedPtr<ISettingsContainer>& Container);
+
+		/** Counts the checked sections of a category from the bits. */
+		FSelectionCounts CountSelection(int32 CategoryIndex) const;
 	};
 
-	struct FSectionDataForImport
+	/** A row of the category/section tree, indexing the tab's section table. Category rows have no section index, nor do the section rows UpdateCategory replaced. */
+	struct FTreeItem
 	{
-		FText DisplayName;
-		ECheckBoxState CheckBoxState;
-		FString FilePath;
+		int32 CategoryIndex = INDEX_NONE;
+		int32 SectionIndex = INDEX_NONE;
+		TArray<TSharedPtr<FTreeItem>> Children;
+		/** The children matching the search, which are the ones listed. */
+		TArray<TSharedPtr<FTreeItem>> VisibleChildren;
+		/** Set on sections that are known to be identical to their import source, which aren't listed. */
+		bool IsUnchanged = false;
 	};
 
-	struct FCategoryDataForImport
+	using FTreeItemPtr = TSharedPtr<FTreeItem>;
+
+	/** One section of a tab, searchable by the lowercased display and internal names of both the section and its category. */
+	struct FSearchEntry
 	{
-		FText DisplayName;
-		TMap<FName, FSectionDataForImport> Sections;
+		FString SearchableText;
+		FTreeItemPtr CategoryItem;
+		FTreeItemPtr SectionItem;
 	};
 
-    using FImportData = TMap<FName, TMap<FName, FString>>;
+	struct FTabSearch
+	{
+		/** In tree order. */
+		TArray<FSearchEntry> Entries;
+		/** Indices of the entries matching Query, in tree order. */
+		TArray<int32> Matches;
+		FString Query;
+	};
 
 public:
 	SLATE_BEGIN_ARGS(SSettingsManagerWindow) { }
 	SLATE_END_ARGS()
 
-	void Construct(const FArguments& InArgs, bool IsForExport, FImportData ImportDataParam);
+	virtual ~SSettingsManagerWindow() override;
+
+	/** The import manifest is only used, and required, when importing. */
+	void Construct(const FArguments& InArgs, bool IsForExport, TSharedPtr<const FSettingsImportData> InImportManifest);
 
 private:
 	template<bool IsForExport>
 	void OnSpawnTab();
 
+	/** Shows a tab, building it first if it's shown for the first time. */
+	template<bool IsForExport>
+	void SelectTab(int TabIndex);
+
 	template<bool IsForExport>
 	TSharedRef<SVerticalBox> CreateTab(int Index);
 
+	/** Sets a section's check state, keeping the category and tab counts in sync. */
+	void SetSectionCheckBoxState(int TabIndex, int32 SectionIndex, ECheckBoxState State);
+
+	void SetCategoryCheckBoxState(int TabIndex, int32 CategoryIndex, ECheckBoxState State);
+
+	/** Narrows the listed sections down to the ones matching the text. */
+	void HandleSearchTextChanged(const FText& SearchText, int TabIndex);
+
+	/** Lists the categories and sections of the current search matches, leaving out the unchanged sections. */
+	void UpdateVisibleItems(int TabIndex);
+
+	template<bool IsForExport>
+	TSharedRef<ITableRow> OnGenerateRow(FTreeItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable, int TabIndex);
+
+	TSharedRef<SWidget> MakePresetsMenu();
+
+	/** Selects exactly the sections of the preset, in this tab and the ones built later. */
+	void ApplyPreset(FString PresetName);
+
+	void SaveSelectionAsPreset(const FString& PresetName);
+
+	/** Patches the rows of a category after the settings module registered or unregistered one of its sections. */
+	void HandleCategoryModified(const FName& CategoryName, int TabIndex);
+
+	/**
+	 * Lists the current sections of a category in place of the ones listed so far, keeping the state of the sections still registered.
+	 * A category that wasn't listed yet is added last. The rows of the other categories are left alone.
+	 */
+	template<bool IsForExport>
+	void UpdateCategory(int TabIndex, FName CategoryName);
+
+	static bool IsSectionSavedProjectBased(const TSharedPtr<ISettingsSection>& Section);
+
+	/** Whether a section is saved at the level opposite to the container it's listed in (e.g. a project-level setting in Editor Preferences). */
+	static bool IsSavedAtReverseLevel(FName ContainerName, bool IsProjectBased);
+
+	FText GetTabTitle(int TabIndex) const;
+
+	/**
+	 * Whether the sections of every tab can be processed at once. Always true when exporting, but a folder exported from a single container
+	 * could have sections matching the ones of other containers, so only archives and combined exports are imported into every container.
+	 */
+	bool CanProcessAllContainers() const;
+
+	/**
+	 * Adds the checked sections of a tab, the ones of the tab's default selection if it was never shown, and reports the ones no longer registered.
+	 * The export files go to Folder.
+	 */
+	template<bool IsForExport>
+	void GatherCheckedSections(int TabIndex, const FString& Folder, TArray<FSettingsSectionFile>& OutSections, TArray<FText>& OutFailures);
+
 	FReply DoExport();
 	FReply DoImport();
 
-	EVisibility GetTabVisibility(int Index) const;
+	/** Diffs every section of the current import tab against its live state, and only lists the ones that would change. */
+	FReply ShowDifferences();
+
+	/** Forgets the differences of a tab's sections, which no longer hold once they're imported, and lists them all again. */
+	void ClearDifferences(int TabIndex);
 
 	static void ShowNotification(const FText& Text, SNotificationItem::ECompletionState CompletionState);
 
@@ -65,8 +196,26 @@ private:
 	TArray<TSharedPtr<ISettingsContainer>> SettingsContainers;
 
 	int CurrentTabIndex = 0;
-
-	FImportData ImportData;
-	TArray<TMap<FName, FCategoryDataForExport>> SettingsDataToExport;
-	TArray<TMap<FName, FCategoryDataForImport>> SettingsDataToImport;
+	bool ExportAsArchive = false;
+	bool IncrementalExport = false;
+	bool MergeImport = false;
+	/** Exports or imports the sections of every tab at once instead of only the current one's. */
+	bool AllContainers = false;
+
+	/** Set while an export is written, which keeps the Export button disabled until it finishes or is cancelled. */
+	TSharedPtr<FSettingsExportTask> RunningExportTask;
+	TSharedPtr<const FSettingsImportData> ImportManifest;
+	/** The sections of the last applied preset, also selected in the tabs built afterwards. */
+	TOptional<TSet<FSettingsSectionKey>> AppliedPreset;
+	TArray<FSectionTable> SectionTables;
+	TArray<FSelectionCounts> TabSelectionCounts;
+
+	TArray<TArray<FTreeItemPtr>> TreeRootItems;
+	/** The categories with sections matching the search, which are the ones listed. */
+	TArray<TArray<FTreeItemPtr>> VisibleRootItems;
+	TArray<FTabSearch> TabSearches;
+	TArray<TSharedPtr<STreeView<FTreeItemPtr>>> TreeViews;
+	/** Null until the tab is first shown. */
+	TArray<TSharedPtr<SVerticalBox>> TabWidgets;
+	TSharedPtr<SBox> TabContent;
 };
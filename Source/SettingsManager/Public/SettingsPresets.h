@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SettingsManagerOperations.h"
+
+/**
+ * Named sets of sections to export or import, shared by every project of the engine installation.
+ * Each preset is stored as a single line of the editor settings, e.g. "Name|Editor/General/Appearance,Project/Engine/Rendering".
+ */
+class FSettingsPresets
+{
+public:
+	static TArray<FString> GetPresetNames();
+
+	/** Returns false if there's no such preset. */
+	static bool LoadPreset(const FString& Name, TSet<FSettingsSectionKey>& OutKeys);
+
+	/** Creates or replaces the preset. The name can't contain '|'. */
+	static bool SavePreset(const FString& Name, const TSet<FSettingsSectionKey>& Keys);
+
+	static void DeletePreset(const FString& Name);
+
+private:
+	static TArray<FString> LoadEntries();
+	static void SaveEntries(const TArray<FString>& Entries);
+	static int32 FindEntry(const TArray<FString>& Entries, const FString& Name);
+};
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SettingsManagerOperations.h"
+
+/**
+ * The sections of each import as they were right before it, so that the import can be rolled back.
+ * Kept in Saved/SettingsManager/Snapshots of the project as a content-addressed store: the ini text of a section is stored once per distinct
+ * contents as Objects/<SHA-1>.ini, and each snapshot is an index of "<SHA-1> Container/Category/Section" lines. Snapshotting sections whose
+ * contents are already stored therefore only writes a line of the index.
+ */
+class FSettingsSnapshots
+{
+public:
+	/** Builds a new snapshot section by section. */
+	class FBuilder
+	{
+	public:
+		/** Captures the whole section and stores its contents unless the store already has them. Must be called on the game thread. */
+		bool AddSection(const FSettingsSectionFile& Section);
+
+		/**
+		 * Writes the index of the snapshot, named after the current time, and prunes the snapshots beyond SettingsManager.MaxSnapshots.
+		 * Returns the name of the snapshot, or an empty string if no section was added or the index couldn't be written.
+		 */
+		FString Save();
+
+	private:
+		/** "Container/Category/Section" -> hash of its contents. */
+		TArray<TPair<FString, FString>> Entries;
+		/** Hashes known to be in the store, so that each one is only looked up once. */
+		TSet<FString> StoredHashes;
+		int32 NumNewContents = 0;
+		bool IsStoreCreated = false;
+		double ElapsedSeconds = 0.0;
+	};
+
+	/** Newest first. */
+	static TArray<FString> GetSnapshotNames();
+
+	/**
+	 * The sections of the snapshot, to be imported from their stored contents by FSettingsManagerOperations::ImportSections.
+	 * Sections that are no longer registered are added to OutFailures. Returns false if there's no such snapshot.
+	 */
+	static bool LoadSnapshot(const FString& Name, TArray<FSettingsSectionFile>& OutSections, TArray<FText>& OutFailures);
+
+	static FString GetStoreFolder();
+
+private:
+	static FString GetObjectPath(const FString& Hash);
+	static FString GetIndexPath(const FString& Name);
+
+	/** Deletes the oldest snapshots beyond SettingsManager.MaxSnapshots, and then the contents no remaining snapshot refers to. */
+	static void Prune();
+};
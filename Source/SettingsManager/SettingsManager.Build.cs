@@ -43,6 +43,7 @@ public class SettingsManager : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Json",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);